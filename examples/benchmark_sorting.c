@@ -1,109 +1,573 @@
 // -*- mode: C; indent-tabs-mode: nil; c-basic-offset: 2; tab-width: 2; -*-
 
+// Sorting benchmark suite.
+//
+// Every algorithm is timed on every input distribution and size: after
+// `warmup` untimed runs, each of `reps` runs sorts a fresh copy of the same
+// input and is timed with CLOCK_MONOTONIC. The table, CSV or JSON output
+// reports the median, p95, standard deviation and minimum of those runs and
+// the throughput at the median, so results of two versions can be diffed.
+//
+//   benchmark_sorting --sizes 1000,1000000,100000000 --reps 5 --format csv
+//   benchmark_sorting --algo Pdqsort --dist random,sawtooth --format json
+//
+// With --counters, each timed run is also wrapped in hardware performance
+// counters (cycles, instructions, branch misses, L1D/LLC/dTLB misses; see
+// omnic/perfcount.h) and their mean per run is reported next to the times.
+// Counters the system does not provide are reported as n/a (empty in CSV,
+// null in JSON).
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "omnic/perfcount.h"
 #include "omnic/sorting.h"
 
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
-#define NUM_SIZES 4
-const int TEST_SIZES[NUM_SIZES] = {500, 10000, 50000, 100000};
+// --- Configuration ---
+
+#define MAX_SIZES 16
+// Largest accepted size; keys and payloads are ints.
+#define MAX_SIZE ((size_t)100000000)
+// Quadratic algorithms are skipped above this size.
+#define QUADRATIC_MAX_SIZE ((size_t)20000)
+
+static const size_t DEFAULT_SIZES[] = {1000, 100000, 1000000, 10000000};
+
+typedef enum { FORMAT_TABLE, FORMAT_CSV, FORMAT_JSON } format_t;
+
+typedef struct {
+  size_t sizes[MAX_SIZES];
+  size_t num_sizes;
+  unsigned warmup;
+  unsigned reps;
+  const char* algo;  // Only algorithms whose name contains this; NULL = all
+  const char* dist;  // Comma-separated distribution names; NULL = all
+  format_t format;
+  uint64_t seed;
+  bool counters;  // Report hardware performance counters
+} options_t;
+
+// --- Algorithms ---
 
 typedef void (*sort_func_t)(oc_sort_list_t*);
 
+// Uses every online CPU.
+static void merge_parallel(oc_sort_list_t* list) {
+  oc_sort_merge_parallel(list, 0);
+}
+
+static void sample_parallel(oc_sort_list_t* list) {
+  oc_sort_sample_parallel(list, 0);
+}
+
+// Without a heap buffer.
+static void merge_in_place(oc_sort_list_t* list) {
+  oc_sort_merge_in_place(list, 0);
+}
+
+// Path taken by the last oc_sort_auto() call, reported with its results.
+static oc_sort_path_t g_auto_path = OC_SORT_PATH_NONE;
+
+static void sort_auto(oc_sort_list_t* list) {
+  g_auto_path = oc_sort_auto(list).path;
+}
+
 typedef struct {
   const char* name;
   sort_func_t func;
+  size_t max_n;       // Skipped above this size; 0 = no limit
+  bool reports_path;  // Sets g_auto_path
 } algorithm_t;
 
-algorithm_t ALGORITHMS[] = {{"Selection Sort", oc_sort_selection},
-                            {"Insertion Sort", oc_sort_insertion},
-                            {"Bubble Sort", oc_sort_bubble},
-                            {"Quick Sort", oc_sort_quick},
-                            {"Merge Sort", oc_sort_merge},
-                            {"Heap Sort", oc_sort_heap},
-                            {NULL, NULL}};
-
-// Helper to generate random data
-void generate_random_data(oc_sort_list_t* list, int n) {
-  list->n = n;
-  for (int i = 1; i <= n; ++i) {
-    list->d[i].key = rand();
-    list->d[i].data = i;  // Dummy data
+static const algorithm_t ALGORITHMS[] = {
+    {"Selection Sort", oc_sort_selection, QUADRATIC_MAX_SIZE, false},
+    {"Insertion Sort", oc_sort_insertion, QUADRATIC_MAX_SIZE, false},
+    {"Bubble Sort", oc_sort_bubble, QUADRATIC_MAX_SIZE, false},
+    {"Quick Sort", oc_sort_quick, 0, false},
+    {"Pdqsort", oc_sort_pdq, 0, false},
+    {"Merge Sort", oc_sort_merge, 0, false},
+    {"Bottom-up Merge Sort", oc_sort_merge_bottom_up, 0, false},
+    {"In-place Merge Sort", merge_in_place, 0, false},
+    {"Parallel Merge Sort", merge_parallel, 0, false},
+    {"Parallel Sample Sort", sample_parallel, 0, false},
+    {"Timsort", oc_sort_tim, 0, false},
+    {"Heap Sort", oc_sort_heap, 0, false},
+    {"D-ary Heap Sort", oc_sort_heap_dary, 0, false},
+    {"Radix Sort", oc_sort_radix, 0, false},
+    {"Counting Sort", oc_sort_counting, 0, false},
+    {"Auto Sort", sort_auto, 0, true},
+    {NULL, NULL, 0, false}};
+
+// --- Input Distributions ---
+
+typedef enum {
+  DIST_RANDOM,
+  DIST_SORTED,
+  DIST_REVERSED,
+  DIST_ORGAN_PIPE,
+  DIST_FEW_UNIQUE,
+  DIST_ALL_EQUAL,
+  DIST_SAWTOOTH,
+  DIST_COUNT
+} dist_t;
+
+static const char* DIST_NAMES[DIST_COUNT] = {
+    "random",     "sorted",    "reversed", "organ-pipe",
+    "few-unique", "all-equal", "sawtooth"};
+
+// splitmix64: fast, and the same sequence on every platform.
+static uint64_t next_random(uint64_t* state) {
+  uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+// Fills `d` with n entries of the given shape; the payload is the position.
+static void generate(oc_sort_entry_t* d, size_t n, dist_t dist,
+                     uint64_t seed) {
+  uint64_t state = seed;
+  size_t tooth = n / 32 + 1;  // 32 ascending runs
+  for (size_t i = 0; i < n; ++i) {
+    int key = 0;
+    switch (dist) {
+      case DIST_RANDOM:
+        key = (int)(uint32_t)(next_random(&state) >> 32);
+        break;
+      case DIST_SORTED:
+        key = (int)i;
+        break;
+      case DIST_REVERSED:
+        key = (int)(n - i);
+        break;
+      case DIST_ORGAN_PIPE:
+        key = (int)(i < n / 2 ? i : n - i);
+        break;
+      case DIST_FEW_UNIQUE:
+        key = (int)(next_random(&state) % 16);
+        break;
+      case DIST_ALL_EQUAL:
+        key = 42;
+        break;
+      case DIST_SAWTOOTH:
+        key = (int)(i % tooth);
+        break;
+      default:
+        break;
+    }
+    d[i].key = key;
+    d[i].data = (int)i;
   }
 }
 
-// Helper to copy list
-void copy_list(oc_sort_list_t* dest, const oc_sort_list_t* src) {
-  dest->n = src->n;
-  // Only copy valid range to save time?
-  // But memcpy is fast. Let's copy strictly 1..n
-  // Or just memcpy the whole array if n is close to max.
-  // Ideally:
-  for (int i = 1; i <= src->n; ++i) {
-    dest->d[i] = src->d[i];
+// --- Measurement ---
+
+typedef struct {
+  double median_ms;
+  double p95_ms;
+  double stddev_ms;
+  double min_ms;
+  double elements_per_sec;  // At the median time
+  // Mean counts per timed run; counter_valid is false if any run missed one.
+  double counter[OC_PERF_EVENT_COUNT];
+  bool counter_valid[OC_PERF_EVENT_COUNT];
+} stats_t;
+
+static double now_ms(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e3 + (double)ts.tv_nsec / 1e6;
+}
+
+static int cmp_double(const void* a, const void* b) {
+  double x = *(const double*)a, y = *(const double*)b;
+  return (x > y) - (x < y);
+}
+
+static bool is_sorted(const oc_sort_entry_t* d, size_t n) {
+  for (size_t i = 1; i < n; ++i) {
+    if (d[i - 1].key > d[i].key)
+      return false;
   }
+  return true;
 }
 
-// Check if sorted
-int is_sorted(const oc_sort_list_t* list) {
-  for (int i = 1; i < list->n; ++i) {
-    if (list->d[i].key > list->d[i + 1].key)
-      return 0;
+// Sorts fresh copies of `input` warmup + reps times and summarizes the timed
+// runs in `times` (reps entries). If `pc` is not NULL the timed runs are
+// also counted. Returns false if a run did not sort.
+static bool measure(const algorithm_t* algo, const oc_sort_entry_t* input,
+                    oc_sort_entry_t* work, size_t n, const options_t* opt,
+                    oc_perf_counters_t* pc, double* times, stats_t* stats) {
+  bool sorted = true;
+  for (int e = 0; e < OC_PERF_EVENT_COUNT; ++e) {
+    stats->counter[e] = 0.0;
+    stats->counter_valid[e] = pc != NULL;
   }
-  return 1;
+  for (unsigned r = 0; r < opt->warmup + opt->reps; ++r) {
+    memcpy(work, input, n * sizeof(oc_sort_entry_t));
+    oc_sort_list_t list = oc_sort_list_view(work, n);
+    bool timed = r >= opt->warmup;
+    oc_perf_sample_t sample;
+    if (pc && timed)
+      oc_perf_start(pc);
+    double start = now_ms();
+    algo->func(&list);
+    double elapsed = now_ms() - start;
+    if (pc && timed)
+      oc_perf_stop(pc, &sample);
+    if (timed)
+      times[r - opt->warmup] = elapsed;
+    for (int e = 0; pc && timed && e < OC_PERF_EVENT_COUNT; ++e) {
+      stats->counter[e] += (double)sample.value[e] / opt->reps;
+      stats->counter_valid[e] = stats->counter_valid[e] && sample.valid[e];
+    }
+    sorted = sorted && is_sorted(work, n);
+  }
+
+  unsigned reps = opt->reps;
+  double mean = 0.0, var = 0.0;
+  for (unsigned r = 0; r < reps; ++r)
+    mean += times[r] / reps;
+  for (unsigned r = 0; r < reps; ++r)
+    var += (times[r] - mean) * (times[r] - mean);
+  stats->stddev_ms = reps > 1 ? sqrt(var / (reps - 1)) : 0.0;
+
+  qsort(times, reps, sizeof(double), cmp_double);
+  stats->median_ms = reps % 2 ? times[reps / 2]
+                              : (times[reps / 2 - 1] + times[reps / 2]) / 2;
+  // Nearest-rank percentile.
+  stats->p95_ms = times[(size_t)ceil(0.95 * reps) - 1];
+  stats->min_ms = times[0];
+  stats->elements_per_sec =
+      stats->median_ms > 0.0 ? (double)n / (stats->median_ms / 1e3) : 0.0;
+  return sorted;
 }
 
-int main(void) {
-  srand((unsigned int)time(NULL));
+// --- Output ---
 
-  // Allocate lists on heap to avoid stack overflow
-  oc_sort_list_t* original = (oc_sort_list_t*)malloc(sizeof(oc_sort_list_t));
-  oc_sort_list_t* working = (oc_sort_list_t*)malloc(sizeof(oc_sort_list_t));
+// Column titles of the counters in the table.
+static const char* COUNTER_TITLES[OC_PERF_EVENT_COUNT] = {
+    "Cycles", "Instr", "Br-miss", "L1D-miss", "LLC-miss", "dTLB-miss"};
 
-  if (!original || !working) {
-    fprintf(stderr, "Memory allocation failed\n");
-    return 1;
+static void print_rule(const options_t* opt) {
+  printf("+----------------------+------------+------------+------------+"
+         "------------+------------+------------+-----------+");
+  for (int e = 0; opt->counters && e < OC_PERF_EVENT_COUNT; ++e)
+    printf("-----------+");
+  printf("\n");
+}
+
+// Formats a count with a K/M/G/T suffix to fit a table column.
+static void format_count(double v, bool valid, char* buf, size_t size) {
+  static const char SUFFIX[] = " KMGT";
+  int i = 0;
+  while (v >= 999.5 && i < 4) {
+    v /= 1000.0;
+    ++i;
   }
+  if (!valid)
+    snprintf(buf, size, "n/a");
+  else if (i == 0)
+    snprintf(buf, size, "%.0f", v);
+  else
+    snprintf(buf, size, "%.3g%c", v, SUFFIX[i]);
+}
 
-  // Print table header
-  printf("+---------------------+------------+-----------+\n");
-  printf("| %-19s | %-10s | %-9s |\n", "Algorithm", "Data Size", "Time (ms)");
-  printf("+---------------------+------------+-----------+\n");
+static void print_header(const options_t* opt) {
+  switch (opt->format) {
+    case FORMAT_TABLE:
+      printf("Warmup runs: %u, timed runs: %u%s\n", opt->warmup, opt->reps,
+             opt->counters ? ", counters are means per run" : "");
+      print_rule(opt);
+      printf("| %-20s | %-10s | %10s | %10s | %10s | %10s | %10s | %-9s |",
+             "Algorithm", "Input", "N", "Median ms", "p95 ms", "Stddev ms",
+             "Melem/s", "Path");
+      for (int e = 0; opt->counters && e < OC_PERF_EVENT_COUNT; ++e)
+        printf(" %9s |", COUNTER_TITLES[e]);
+      printf("\n");
+      print_rule(opt);
+      break;
+    case FORMAT_CSV:
+      printf("algorithm,distribution,n,warmup,repetitions,median_ms,p95_ms,"
+             "stddev_ms,min_ms,elements_per_sec,path");
+      for (int e = 0; opt->counters && e < OC_PERF_EVENT_COUNT; ++e)
+        printf(",%s", oc_perf_event_name((oc_perf_event_t)e));
+      printf("\n");
+      break;
+    case FORMAT_JSON:
+      printf("[");
+      break;
+  }
+}
 
-  for (int s = 0; s < NUM_SIZES; ++s) {
-    int n = TEST_SIZES[s];
-    generate_random_data(original, n);
+static void print_result(const options_t* opt, const algorithm_t* algo,
+                         dist_t dist, size_t n, const stats_t* s,
+                         bool first) {
+  // The path of the last run stands for all runs: the input is the same.
+  const char* path = algo->reports_path ? oc_sort_path_name(g_auto_path) : "";
+  switch (opt->format) {
+    case FORMAT_TABLE:
+      printf("| %-20s | %-10s | %10zu | %10.3f | %10.3f | %10.3f | %10.2f |"
+             " %-9s |",
+             algo->name, DIST_NAMES[dist], n, s->median_ms, s->p95_ms,
+             s->stddev_ms, s->elements_per_sec / 1e6, path);
+      for (int e = 0; opt->counters && e < OC_PERF_EVENT_COUNT; ++e) {
+        char buf[16];
+        format_count(s->counter[e], s->counter_valid[e], buf, sizeof(buf));
+        printf(" %9s |", buf);
+      }
+      printf("\n");
+      break;
+    case FORMAT_CSV:
+      printf("%s,%s,%zu,%u,%u,%.6f,%.6f,%.6f,%.6f,%.0f,%s", algo->name,
+             DIST_NAMES[dist], n, opt->warmup, opt->reps, s->median_ms,
+             s->p95_ms, s->stddev_ms, s->min_ms, s->elements_per_sec, path);
+      for (int e = 0; opt->counters && e < OC_PERF_EVENT_COUNT; ++e) {
+        if (s->counter_valid[e])
+          printf(",%.0f", s->counter[e]);
+        else
+          printf(",");
+      }
+      printf("\n");
+      break;
+    case FORMAT_JSON:
+      printf("%s\n  {\"algorithm\": \"%s\", \"distribution\": \"%s\", "
+             "\"n\": %zu, \"warmup\": %u, \"repetitions\": %u, "
+             "\"median_ms\": %.6f, \"p95_ms\": %.6f, \"stddev_ms\": %.6f, "
+             "\"min_ms\": %.6f, \"elements_per_sec\": %.0f",
+             first ? "" : ",", algo->name, DIST_NAMES[dist], n, opt->warmup,
+             opt->reps, s->median_ms, s->p95_ms, s->stddev_ms, s->min_ms,
+             s->elements_per_sec);
+      for (int e = 0; opt->counters && e < OC_PERF_EVENT_COUNT; ++e) {
+        if (s->counter_valid[e])
+          printf(", \"%s\": %.0f", oc_perf_event_name((oc_perf_event_t)e),
+                 s->counter[e]);
+        else
+          printf(", \"%s\": null", oc_perf_event_name((oc_perf_event_t)e));
+      }
+      if (algo->reports_path)
+        printf(", \"path\": \"%s\"", path);
+      else
+        printf(", \"path\": null");
+      printf("}");
+      break;
+  }
+  fflush(stdout);
+}
 
-    for (int a = 0; ALGORITHMS[a].name != NULL; ++a) {
-      // Copy data
-      copy_list(working, original);
+static void print_size_end(const options_t* opt) {
+  if (opt->format == FORMAT_TABLE)
+    print_rule(opt);
+}
 
-      // Measure time
-      clock_t start = clock();
-      ALGORITHMS[a].func(working);
-      clock_t end = clock();
+static void print_footer(const options_t* opt) {
+  if (opt->format == FORMAT_JSON)
+    printf("\n]\n");
+}
 
-      double elapsed_ms = (double)(end - start) * 1000.0 / CLOCKS_PER_SEC;
+// --- Command Line ---
 
-      // Verify (optional, but good for debugging)
-      if (!is_sorted(working)) {
-        fprintf(stderr, "Error: %s failed to sort for N=%d\n",
-                ALGORITHMS[a].name, n);
-      }
+static void usage(const char* prog) {
+  fprintf(stderr,
+          "Usage: %s [options]\n"
+          "  --sizes N[,N...]   input sizes, up to 100000000 "
+          "(default 1000,100000,1000000,10000000)\n"
+          "  --reps N           timed runs per measurement (default 10)\n"
+          "  --warmup N         untimed runs first (default 1)\n"
+          "  --algo NAME        only algorithms whose name contains NAME\n"
+          "  --dist D[,D...]    distributions: random, sorted, reversed,\n"
+          "                     organ-pipe, few-unique, all-equal, sawtooth\n"
+          "  --format F         table (default), csv or json\n"
+          "  --seed N           seed for the random inputs (default 1)\n"
+          "  --counters         also report hardware performance counters\n",
+          prog);
+}
 
-      printf("| %-19s | %10d | %9.2f |\n", ALGORITHMS[a].name, n, elapsed_ms);
+static bool parse_sizes(const char* arg, options_t* opt) {
+  opt->num_sizes = 0;
+  const char* p = arg;
+  while (*p) {
+    char* end;
+    unsigned long long v = strtoull(p, &end, 10);
+    if (end == p || v == 0 || v > MAX_SIZE || opt->num_sizes == MAX_SIZES ||
+        (*end != ',' && *end != '\0')) {
+      return false;
+    }
+    opt->sizes[opt->num_sizes++] = (size_t)v;
+    p = *end ? end + 1 : end;
+  }
+  return opt->num_sizes > 0;
+}
+
+static bool parse_count(const char* arg, unsigned min, unsigned* out) {
+  char* end;
+  unsigned long v = strtoul(arg, &end, 10);
+  if (end == arg || *end != '\0' || v < min || v > 1000000)
+    return false;
+  *out = (unsigned)v;
+  return true;
+}
+
+// Whether `name` is an element of the comma-separated `list`.
+static bool list_contains(const char* list, const char* name) {
+  size_t len = strlen(name);
+  for (const char* p = list; p; p = strchr(p, ',')) {
+    if (*p == ',')
+      ++p;
+    if (strncmp(p, name, len) == 0 && (p[len] == ',' || p[len] == '\0'))
+      return true;
+  }
+  return false;
+}
+
+// Whether every element of the comma-separated `list` names a distribution.
+static bool valid_dists(const char* list) {
+  size_t found = 0, elements = 1;
+  for (const char* p = list; *p; ++p)
+    elements += *p == ',';
+  for (int d = 0; d < DIST_COUNT; ++d)
+    found += list_contains(list, DIST_NAMES[d]);
+  return found == elements;
+}
 
-      // Flush to ensure output is seen immediately
-      fflush(stdout);
+static bool parse_options(int argc, char** argv, options_t* opt) {
+  memcpy(opt->sizes, DEFAULT_SIZES, sizeof(DEFAULT_SIZES));
+  opt->num_sizes = sizeof(DEFAULT_SIZES) / sizeof(DEFAULT_SIZES[0]);
+  opt->warmup = 1;
+  opt->reps = 10;
+  opt->algo = NULL;
+  opt->dist = NULL;
+  opt->format = FORMAT_TABLE;
+  opt->seed = 1;
+  opt->counters = false;
+
+  for (int i = 1; i < argc; ++i) {
+    const char* flag = argv[i];
+    if (strcmp(flag, "--counters") == 0) {
+      opt->counters = true;
+      continue;
+    }
+    const char* arg = i + 1 < argc ? argv[i + 1] : NULL;
+    bool ok = arg != NULL;
+    if (strcmp(flag, "--sizes") == 0) {
+      ok = ok && parse_sizes(arg, opt);
+    } else if (strcmp(flag, "--reps") == 0) {
+      ok = ok && parse_count(arg, 1, &opt->reps);
+    } else if (strcmp(flag, "--warmup") == 0) {
+      ok = ok && parse_count(arg, 0, &opt->warmup);
+    } else if (strcmp(flag, "--algo") == 0) {
+      opt->algo = arg;
+    } else if (strcmp(flag, "--dist") == 0) {
+      opt->dist = arg;
+      ok = ok && valid_dists(arg);
+    } else if (strcmp(flag, "--format") == 0) {
+      if (ok && strcmp(arg, "table") == 0)
+        opt->format = FORMAT_TABLE;
+      else if (ok && strcmp(arg, "csv") == 0)
+        opt->format = FORMAT_CSV;
+      else if (ok && strcmp(arg, "json") == 0)
+        opt->format = FORMAT_JSON;
+      else
+        ok = false;
+    } else if (strcmp(flag, "--seed") == 0) {
+      if (ok)
+        opt->seed = strtoull(arg, NULL, 10);
+    } else {
+      ok = false;
+    }
+    if (!ok) {
+      fprintf(stderr, "Invalid option: %s%s%s\n", flag, arg ? " " : "",
+              arg ? arg : "");
+      return false;
+    }
+    ++i;
+  }
+  return true;
+}
+
+// --- Main ---
+
+int main(int argc, char** argv) {
+  options_t opt;
+  if (!parse_options(argc, argv, &opt)) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  // Size the buffers for the largest test; the lists only view them
+  size_t max_n = 0;
+  for (size_t s = 0; s < opt.num_sizes; ++s) {
+    if (opt.sizes[s] > max_n)
+      max_n = opt.sizes[s];
+  }
+
+  oc_sort_entry_t* input =
+      (oc_sort_entry_t*)malloc(max_n * sizeof(oc_sort_entry_t));
+  oc_sort_entry_t* work =
+      (oc_sort_entry_t*)malloc(max_n * sizeof(oc_sort_entry_t));
+  double* times = (double*)malloc(opt.reps * sizeof(double));
+  if (!input || !work || !times) {
+    fprintf(stderr, "Memory allocation failed\n");
+    free(input);
+    free(work);
+    free(times);
+    return 1;
+  }
+
+  oc_perf_counters_t counters;
+  oc_perf_counters_t* pc = NULL;
+  if (opt.counters) {
+    pc = &counters;
+    if (oc_perf_open(pc) < OC_PERF_EVENT_COUNT) {
+      fprintf(stderr, "Note: unavailable hardware counters:");
+      for (int e = 0; e < OC_PERF_EVENT_COUNT; ++e) {
+        if (!oc_perf_available(pc, (oc_perf_event_t)e))
+          fprintf(stderr, " %s", oc_perf_event_name((oc_perf_event_t)e));
+      }
+      fprintf(stderr, " (check perf_event_paranoid)\n");
     }
-    // Separator between different sizes
-    printf("+---------------------+------------+-----------+\n");
   }
 
-  free(original);
-  free(working);
+  int status = 0;
+  bool first = true;
+  print_header(&opt);
+  for (size_t s = 0; s < opt.num_sizes; ++s) {
+    size_t n = opt.sizes[s];
+    for (int d = 0; d < DIST_COUNT; ++d) {
+      if (opt.dist && !list_contains(opt.dist, DIST_NAMES[d]))
+        continue;
+      generate(input, n, (dist_t)d, opt.seed);
+
+      for (const algorithm_t* a = ALGORITHMS; a->name != NULL; ++a) {
+        if ((a->max_n && n > a->max_n) ||
+            (opt.algo && !strstr(a->name, opt.algo))) {
+          continue;
+        }
+        stats_t stats;
+        if (!measure(a, input, work, n, &opt, pc, times, &stats)) {
+          fprintf(stderr, "Error: %s failed to sort %s input, N=%zu\n",
+                  a->name, DIST_NAMES[d], n);
+          status = 1;
+        }
+        print_result(&opt, a, (dist_t)d, n, &stats, first);
+        first = false;
+      }
+    }
+    print_size_end(&opt);
+  }
+  print_footer(&opt);
 
-  return 0;
+  if (pc)
+    oc_perf_close(pc);
+  free(input);
+  free(work);
+  free(times);
+  return status;
 }
@@ -0,0 +1,96 @@
+// -*- mode: C; indent-tabs-mode: nil; c-basic-offset: 2; tab-width: 2; -*-
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <omnic/allocator.h>
+#include <omnic/macros.h>
+
+// --- Test Framework Setup ---
+
+// Global counter for failed tests
+static int g_test_failures = 0;
+
+// --- Helpers ---
+
+// A malloc-backed allocator without a realloc callback that tracks the
+// bytes it has handed out, checking the sizes passed back to free.
+typedef struct {
+  size_t live_bytes;
+  size_t allocs, frees;
+} tracker_t;
+
+static void* tracker_alloc(void* ctx, size_t size) {
+  tracker_t* t = (tracker_t*)ctx;
+  t->live_bytes += size;
+  t->allocs++;
+  return malloc(size);
+}
+
+static void tracker_free(void* ctx, void* ptr, size_t size) {
+  tracker_t* t = (tracker_t*)ctx;
+  t->live_bytes -= size;
+  t->frees++;
+  free(ptr);
+}
+
+// --- Test Functions ---
+
+void test_default_allocator() {
+  printf("--- Testing the Default Allocator ---\n");
+  const oc_allocator_t* a = oc_allocator_default();
+  ASSERT(a && a->alloc && a->realloc && a->free, "Callbacks are set");
+  ASSERT(oc_allocator_default() == a, "The default is a single instance");
+
+  char* p = (char*)oc_allocator_alloc(NULL, 16);
+  ASSERT(p != NULL, "NULL selects the default allocator");
+  strcpy(p, "omnic");
+  p = (char*)oc_allocator_realloc(a, p, 16, 4096);
+  ASSERT(p && strcmp(p, "omnic") == 0, "Realloc keeps the contents");
+  oc_allocator_free(a, p, 4096);
+  oc_allocator_free(a, NULL, 0);  // Ignored
+
+  ASSERT(oc_allocator_alloc(a, 0) == NULL, "Zero bytes allocate nothing");
+}
+
+void test_realloc_fallback() {
+  printf("--- Testing Realloc Without a Callback ---\n");
+  tracker_t t = {0, 0, 0};
+  oc_allocator_t a = {tracker_alloc, NULL, tracker_free, &t};
+
+  int* p = (int*)oc_allocator_realloc(&a, NULL, 0, 4 * sizeof(int));
+  ASSERT(p != NULL, "Realloc of NULL allocates");
+  for (int i = 0; i < 4; ++i)
+    p[i] = i + 1;
+  p = (int*)oc_allocator_realloc(&a, p, 4 * sizeof(int), 100 * sizeof(int));
+  ASSERT(p && p[0] == 1 && p[3] == 4, "Contents are copied to the new block");
+  ASSERT_EQ(t.allocs, (size_t)2, "%zu", "The fallback allocates a new block");
+  ASSERT_EQ(t.frees, (size_t)1, "%zu", "and frees the old one");
+  ASSERT_EQ(t.live_bytes, 100 * sizeof(int), "%zu",
+            "Only the new block stays live");
+
+  p = (int*)oc_allocator_realloc(&a, p, 100 * sizeof(int), 2 * sizeof(int));
+  ASSERT(p && p[1] == 2, "Shrinking copies the smaller size");
+  oc_allocator_free(&a, p, 2 * sizeof(int));
+  ASSERT_EQ(t.live_bytes, (size_t)0, "%zu", "Everything is returned");
+}
+
+// --- Main Test Runner ---
+
+int main(void) {
+  printf("--- Running OmniC Allocator Test Suite ---\n\n");
+
+  test_default_allocator();
+  test_realloc_fallback();
+
+  printf("\n--- Test Suite Finished ---\n");
+  if (g_test_failures == 0) {
+    printf("Result: ALL TESTS PASSED\n");
+    return EXIT_SUCCESS;
+  }
+
+  printf("Result: %d TEST(S) FAILED\n", g_test_failures);
+  return EXIT_FAILURE;
+}
@@ -6,6 +6,7 @@
 
 #include <omnic/dynarray.h>
 #include <omnic/macros.h>
+#include <omnic/typedsort.h>
 
 // --- Test Framework Setup ---
 
@@ -200,6 +201,56 @@ void test_structs() {
   dafree(da);
 }
 
+// --- Sorting ---
+
+OC_SORT_DEFINE(ints, int, *a < *b)
+
+// Orders points by x, then y descending.
+OC_SORT_DEFINE(points, point_t, a->x < b->x || (a->x == b->x && a->y > b->y))
+
+void test_sort() {
+  printf("--- Testing Sort ---\n");
+  int* da = NULL;
+  dasort(da, ints);  // NULL is an empty array
+  ASSERT(da == NULL, "Sorting an empty array should not allocate");
+
+  // Random, all-equal, ascending and descending inputs, short and long.
+  static const size_t SIZES[] = {1, 2, 17, 1000, 100000};
+  for (size_t s = 0; s < sizeof(SIZES) / sizeof(SIZES[0]); ++s) {
+    for (int pattern = 0; pattern < 4; ++pattern) {
+      size_t n = SIZES[s];
+      long long sum = 0, sorted_sum = 0;
+      for (size_t i = 0; i < n; ++i) {
+        int v = pattern == 0   ? rand() % 1000
+                : pattern == 1 ? 7
+                : pattern == 2 ? (int)i
+                               : (int)(n - i);
+        dapush(da, v);
+        sum += v;
+      }
+      int* before = da;
+      dasort(da, ints);
+      ASSERT(da == before, "Sorting should not move the storage");
+      bool ok = dalen(da) == n;
+      for (size_t i = 0; i < dalen(da); ++i) {
+        ok = ok && (i == 0 || da[i - 1] <= da[i]);
+        sorted_sum += da[i];
+      }
+      ASSERT(ok && sum == sorted_sum, "Array should be sorted in place");
+      dafree(da);
+    }
+  }
+
+  point_t* pts = NULL;
+  for (int i = 0; i < 200; ++i)
+    dapush(pts, ((point_t){(float)(i % 10), (float)i}));
+  dasort(pts, points);
+  ASSERT(points_is_sorted(pts, dalen(pts)), "Structs should sort");
+  ASSERT(points_are_equal(pts[0], ((point_t){0.0f, 190.0f})),
+         "Ties on x should be ordered by the second key");
+  dafree(pts);
+}
+
 // --- Main Test Runner ---
 
 int main(void) {
@@ -210,6 +261,7 @@ int main(void) {
   test_insert_and_erase();
   test_find();
   test_structs();
+  test_sort();
 
   printf("\n--- Test Suite Finished ---\n");
   if (g_test_failures == 0) {
@@ -0,0 +1,175 @@
+// -*- mode: C; indent-tabs-mode: nil; c-basic-offset: 2; tab-width: 2; -*-
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <omnic/extsort.h>
+#include <omnic/macros.h>
+
+// --- Test Framework Setup ---
+
+// Global counter for failed tests
+static int g_test_failures = 0;
+
+static char g_in_path[256];
+static char g_out_path[256];
+
+// --- Helpers ---
+
+// Writes n records with keys in [0, range) and the input position as data.
+static bool write_records(const char* path, size_t n, int range) {
+  FILE* f = fopen(path, "wb");
+  if (!f)
+    return false;
+  bool ok = true;
+  for (size_t i = 0; ok && i < n; ++i) {
+    oc_sort_entry_t e = {rand() % range - range / 2, (oc_data_type_t)i};
+    ok = fwrite(&e, sizeof(e), 1, f) == 1;
+  }
+  return fclose(f) == 0 && ok;
+}
+
+// Checks that `path` holds the n records written by write_records(), sorted
+// by key and, if requested, with equal keys in input order.
+static bool check_output(const char* path, size_t n, bool stable) {
+  FILE* f = fopen(path, "rb");
+  bool* seen = (bool*)calloc(n ? n : 1, sizeof(bool));
+  bool ok = f && seen;
+  oc_sort_entry_t prev = {0, 0}, e;
+  size_t count = 0;
+  while (ok && fread(&e, sizeof(e), 1, f) == 1) {
+    size_t origin = (size_t)e.data;
+    ok = origin < n && !seen[origin];
+    if (ok && count > 0) {
+      ok = prev.key <= e.key &&
+           (!stable || prev.key != e.key || prev.data < e.data);
+    }
+    if (ok)
+      seen[origin] = true;
+    prev = e;
+    ++count;
+  }
+  ok = ok && count == n;
+  if (f)
+    fclose(f);
+  free(seen);
+  return ok;
+}
+
+// --- Test Functions ---
+
+void test_in_memory() {
+  printf("--- Testing Inputs That Fit in Memory ---\n");
+  oc_extsort_stats_t stats;
+  static const size_t SIZES[] = {0, 1, 2, 1000};
+  for (size_t s = 0; s < sizeof(SIZES) / sizeof(SIZES[0]); ++s) {
+    size_t n = SIZES[s];
+    ASSERT(write_records(g_in_path, n, 1 << 20), "Writing input succeeds");
+    oc_error_code_t err = oc_extsort_file(g_in_path, g_out_path, NULL, &stats);
+    ASSERT_EQ(err, OC_SUCCESS, "%d", "Default config should sort the file");
+    ASSERT(check_output(g_out_path, n, false), "Output should be sorted");
+    ASSERT_EQ(stats.records, n, "%zu", "All records should be counted");
+    ASSERT_EQ(stats.runs, (size_t)0, "%zu", "No runs should be spilled");
+  }
+}
+
+void test_multi_pass() {
+  printf("--- Testing Spilled Runs and Multi-pass Merges ---\n");
+  const size_t n = 300007;
+  oc_extsort_config_t cfg = oc_extsort_default_config();
+  cfg.memory_limit = 64 * 1024;  // 8192 records per run
+  cfg.fan_in = 4;
+
+  ASSERT(write_records(g_in_path, n, 1 << 20), "Writing input succeeds");
+  oc_extsort_stats_t stats;
+  oc_error_code_t err = oc_extsort_file(g_in_path, g_out_path, &cfg, &stats);
+  ASSERT_EQ(err, OC_SUCCESS, "%d", "Multi-pass sort should succeed");
+  ASSERT(check_output(g_out_path, n, false), "Output should be sorted");
+  ASSERT_EQ(stats.runs, (n + 8191) / 8192, "%zu",
+            "One run should be spilled per memory-sized chunk");
+  // 37 runs with fan-in 4: 37 -> 10 -> 3 -> output.
+  ASSERT_EQ(stats.merge_passes, (size_t)3, "%zu",
+            "Runs beyond the fan-in should take extra merge passes");
+
+  // A single merge pass once the fan-in covers every run.
+  cfg.fan_in = 64;
+  err = oc_extsort_file(g_in_path, g_out_path, &cfg, &stats);
+  ASSERT_EQ(err, OC_SUCCESS, "%d", "Single-pass sort should succeed");
+  ASSERT(check_output(g_out_path, n, false), "Output should be sorted");
+  ASSERT_EQ(stats.merge_passes, (size_t)1, "%zu",
+            "All runs should merge in one pass");
+}
+
+void test_stable_and_in_place() {
+  printf("--- Testing Stability and In-place Sorting ---\n");
+  const size_t n = 100000;
+  oc_extsort_config_t cfg = oc_extsort_default_config();
+  cfg.memory_limit = 32 * 1024;
+  cfg.fan_in = 3;
+  cfg.sort = oc_sort_tim;
+
+  // Few distinct keys, so most records tie across runs.
+  ASSERT(write_records(g_in_path, n, 16), "Writing input succeeds");
+  oc_error_code_t err = oc_extsort_file(g_in_path, g_in_path, &cfg, NULL);
+  ASSERT_EQ(err, OC_SUCCESS, "%d", "In-place sort should succeed");
+  ASSERT(check_output(g_in_path, n, true),
+         "A stable chunk sort should give a stable external sort");
+}
+
+void test_errors() {
+  printf("--- Testing Error Reporting ---\n");
+  oc_extsort_config_t cfg = oc_extsort_default_config();
+  ASSERT(write_records(g_in_path, 10, 100), "Writing input succeeds");
+
+  cfg.fan_in = 1;
+  ASSERT_EQ(oc_extsort_file(g_in_path, g_out_path, &cfg, NULL),
+            OC_ERROR_INVALID_ARG, "%d", "A fan-in below 2 should be rejected");
+  cfg.fan_in = 64;
+  cfg.memory_limit = 64;
+  ASSERT_EQ(oc_extsort_file(g_in_path, g_out_path, &cfg, NULL),
+            OC_ERROR_INVALID_ARG, "%d",
+            "A budget too small for the fan-in should be rejected");
+
+  ASSERT_EQ(oc_extsort_file("/nonexistent/omnic-input", g_out_path, NULL,
+                            NULL),
+            OC_ERROR_IO, "%d", "A missing input should report an I/O error");
+
+  // A trailing partial record.
+  FILE* f = fopen(g_in_path, "ab");
+  ASSERT(f && fputc(1, f) != EOF && fclose(f) == 0, "Appending succeeds");
+  ASSERT_EQ(oc_extsort_file(g_in_path, g_out_path, NULL, NULL),
+            OC_ERROR_INVALID_ARG, "%d",
+            "A truncated record should be rejected");
+}
+
+// --- Main Test Runner ---
+
+int main(void) {
+  printf("--- Running OmniC External Sort Test Suite ---\n\n");
+  srand(7);
+
+  const char* dir = getenv("TMPDIR");
+  if (!dir || !*dir)
+    dir = "/tmp";
+  snprintf(g_in_path, sizeof(g_in_path), "%s/omnic-extsort-in.bin", dir);
+  snprintf(g_out_path, sizeof(g_out_path), "%s/omnic-extsort-out.bin", dir);
+
+  test_in_memory();
+  test_multi_pass();
+  test_stable_and_in_place();
+  test_errors();
+
+  remove(g_in_path);
+  remove(g_out_path);
+
+  printf("\n--- Test Suite Finished ---\n");
+  if (g_test_failures == 0) {
+    printf("Result: ALL TESTS PASSED\n");
+    return EXIT_SUCCESS;
+  }
+
+  printf("Result: %d TEST(S) FAILED\n", g_test_failures);
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,124 @@
+// -*- mode: C; indent-tabs-mode: nil; c-basic-offset: 2; tab-width: 2; -*-
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <omnic/macros.h>
+#include <omnic/perfcount.h>
+
+// --- Test Framework Setup ---
+
+// Global counter for failed tests
+static int g_test_failures = 0;
+
+// --- Helpers ---
+
+// Enough work that every available counter sees events.
+static unsigned long busy_work(size_t n) {
+  unsigned long* d = (unsigned long*)malloc(n * sizeof(unsigned long));
+  unsigned long sum = 0, x = 88172645463325252ul;
+  if (!d)
+    return 0;
+  for (size_t i = 0; i < n; ++i) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    d[i] = x;
+  }
+  for (size_t i = 0; i < n; ++i)
+    sum += d[d[i] % n] & 1 ? d[i] : 0;  // Random accesses and branches
+  free(d);
+  return sum;
+}
+
+// --- Test Functions ---
+
+void test_names() {
+  printf("--- Testing Event Names ---\n");
+  bool ok = true;
+  for (int e = 0; e < OC_PERF_EVENT_COUNT; ++e) {
+    const char* name = oc_perf_event_name((oc_perf_event_t)e);
+    ok = ok && name && *name && strcmp(name, "unknown") != 0;
+  }
+  ASSERT(ok, "Every event should have a name");
+  ASSERT(strcmp(oc_perf_event_name(OC_PERF_BRANCH_MISSES), "branch-misses") ==
+             0,
+         "Names should match the perf tool");
+}
+
+void test_measure() {
+  printf("--- Testing Counting a Region ---\n");
+  oc_perf_counters_t pc;
+  size_t opened = oc_perf_open(&pc);
+  printf("%zu of %d events available\n", opened, OC_PERF_EVENT_COUNT);
+
+  size_t available = 0;
+  for (int e = 0; e < OC_PERF_EVENT_COUNT; ++e)
+    available += oc_perf_available(&pc, (oc_perf_event_t)e);
+  ASSERT_EQ(available, opened, "%zu",
+            "The open count should match the available events");
+
+  // Unavailable events must read as invalid zeros, available ones as counts.
+  oc_perf_sample_t small, large;
+  oc_perf_start(&pc);
+  volatile unsigned long sink = busy_work(1000);
+  oc_perf_stop(&pc, &small);
+  oc_perf_start(&pc);
+  sink = busy_work(1000000);
+  oc_perf_stop(&pc, &large);
+  (void)sink;
+
+  bool consistent = true;
+  for (int e = 0; e < OC_PERF_EVENT_COUNT; ++e) {
+    bool avail = oc_perf_available(&pc, (oc_perf_event_t)e);
+    consistent = consistent && (avail || (!small.valid[e] &&
+                                          !large.valid[e] &&
+                                          small.value[e] == 0 &&
+                                          large.value[e] == 0));
+    if (large.valid[e])
+      printf("  %-13s %llu\n", oc_perf_event_name((oc_perf_event_t)e),
+             (unsigned long long)large.value[e]);
+  }
+  ASSERT(consistent, "Unavailable events should read as invalid zeros");
+
+  // Each region is counted on its own, not accumulated.
+  if (small.valid[OC_PERF_INSTRUCTIONS] && large.valid[OC_PERF_INSTRUCTIONS]) {
+    ASSERT(small.value[OC_PERF_INSTRUCTIONS] > 0 &&
+               small.value[OC_PERF_INSTRUCTIONS] * 10 <
+                   large.value[OC_PERF_INSTRUCTIONS],
+           "Instruction counts should follow the amount of work");
+  }
+
+  oc_perf_close(&pc);
+  for (int e = 0; e < OC_PERF_EVENT_COUNT; ++e)
+    ASSERT(!oc_perf_available(&pc, (oc_perf_event_t)e),
+           "Closed counters should be unavailable");
+
+  // Starting and stopping closed counters is harmless.
+  oc_perf_start(&pc);
+  oc_perf_stop(&pc, &small);
+  bool none = true;
+  for (int e = 0; e < OC_PERF_EVENT_COUNT; ++e)
+    none = none && !small.valid[e];
+  ASSERT(none, "Closed counters should report nothing");
+}
+
+// --- Main Test Runner ---
+
+int main(void) {
+  printf("--- Running OmniC Performance Counter Test Suite ---\n\n");
+
+  test_names();
+  test_measure();
+
+  printf("\n--- Test Suite Finished ---\n");
+  if (g_test_failures == 0) {
+    printf("Result: ALL TESTS PASSED\n");
+    return EXIT_SUCCESS;
+  }
+
+  printf("Result: %d TEST(S) FAILED\n", g_test_failures);
+  return EXIT_FAILURE;
+}
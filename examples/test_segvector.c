@@ -0,0 +1,173 @@
+// -*- mode: C; indent-tabs-mode: nil; c-basic-offset: 2; tab-width: 2; -*-
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <omnic/macros.h>
+#include <omnic/segvector.h>
+
+// --- Test Framework Setup ---
+
+// Global counter for failed tests
+static int g_test_failures = 0;
+
+// --- Helpers ---
+
+// Counts the blocks an allocator hands out and checks the freed sizes.
+typedef struct {
+  size_t allocs, frees, live_bytes;
+} counter_t;
+
+static void* counting_alloc(void* ctx, size_t size) {
+  counter_t* c = (counter_t*)ctx;
+  c->allocs++;
+  c->live_bytes += size;
+  return malloc(size);
+}
+
+static void counting_free(void* ctx, void* ptr, size_t size) {
+  counter_t* c = (counter_t*)ctx;
+  c->frees++;
+  c->live_bytes -= size;
+  free(ptr);
+}
+
+// --- Test Functions ---
+
+void test_push_and_get() {
+  printf("--- Testing Push, Get and Block Mapping ---\n");
+  ASSERT(oc_segvector_create(0) == NULL, "Zero-sized elements are rejected");
+  oc_segvector_t* vec = oc_segvector_create(sizeof(uint64_t));
+  ASSERT(vec != NULL, "Vector should be created");
+  ASSERT_EQ(oc_segvector_capacity(vec), (size_t)0, "%zu",
+            "No block is allocated up front");
+  ASSERT(oc_segvector_get(vec, 0) == NULL, "An empty vector has no elements");
+
+  const size_t n = 100000;
+  for (uint64_t i = 0; i < n; ++i) {
+    uint64_t v = i * 7;
+    ASSERT_EQ(oc_segvector_push_back(vec, &v), OC_SUCCESS, "%d",
+              "Push should succeed");
+  }
+  ASSERT_EQ(oc_segvector_size(vec), n, "%zu", "Size should match pushes");
+  // Blocks of 16, 32, ..., so the capacity is 16 * (2^k - 1).
+  size_t cap = oc_segvector_capacity(vec);
+  ASSERT(cap >= n && cap < 2 * n + OC_SEGVECTOR_FIRST_BLOCK,
+         "Capacity grows geometrically");
+  ASSERT_EQ((cap / OC_SEGVECTOR_FIRST_BLOCK + 1) &
+                (cap / OC_SEGVECTOR_FIRST_BLOCK),
+            (size_t)0, "%zu", "Capacity is a whole number of blocks");
+
+  bool ok = true;
+  for (size_t i = 0; ok && i < n; ++i)
+    ok = *(const uint64_t*)oc_segvector_get(vec, i) == i * 7;
+  ASSERT(ok, "Every index maps to its element");
+  ASSERT(oc_segvector_get(vec, n) == NULL, "Out of bounds get returns NULL");
+  ASSERT_EQ(oc_segvector_push_back(vec, NULL), OC_ERROR_INVALID_ARG, "%d",
+            "A NULL element is rejected");
+  oc_segvector_destroy(vec);
+}
+
+void test_stable_addresses() {
+  printf("--- Testing Stable Addresses ---\n");
+  oc_segvector_t* vec = oc_segvector_create(sizeof(int));
+  const int* ptrs[64];
+  size_t index[64];
+  size_t tracked = 0;
+  for (int i = 0; i < 1 << 20; ++i) {
+    oc_segvector_push_back(vec, &i);
+    // Remember the first element of every block, right after it is added.
+    size_t start = (size_t)i + OC_SEGVECTOR_FIRST_BLOCK;
+    if ((start & (start - 1)) == 0 && tracked < 64) {
+      index[tracked] = (size_t)i;
+      ptrs[tracked++] = (const int*)oc_segvector_get(vec, (size_t)i);
+    }
+  }
+  ASSERT(tracked > 10, "Growth spans many blocks");
+  bool ok = true;
+  for (size_t t = 0; ok && t < tracked; ++t)
+    ok = ptrs[t] == oc_segvector_get(vec, index[t]) &&
+         *ptrs[t] == (int)index[t];
+  ASSERT(ok, "Pointers taken early still address the same elements");
+  oc_segvector_destroy(vec);
+}
+
+void test_append_and_runs() {
+  printf("--- Testing Bulk Append and Contiguous Runs ---\n");
+  oc_segvector_t* vec = oc_segvector_create(sizeof(int));
+  int values[1000];
+  for (int i = 0; i < 1000; ++i)
+    values[i] = i;
+
+  ASSERT_EQ(oc_segvector_append_n(vec, values, 5), OC_SUCCESS, "%d",
+            "Append within a block");
+  ASSERT_EQ(oc_segvector_append_n(vec, values + 5, 995), OC_SUCCESS, "%d",
+            "Append across blocks");
+  ASSERT_EQ(oc_segvector_append_n(vec, NULL, 0), OC_SUCCESS, "%d",
+            "Appending nothing is fine");
+  ASSERT_EQ(oc_segvector_append_n(vec, NULL, 1), OC_ERROR_INVALID_ARG, "%d",
+            "NULL elements are rejected");
+
+  long long sum = 0;
+  size_t runs = 0, seen = 0, n;
+  for (size_t i = 0; i < oc_segvector_size(vec); i += n) {
+    const int* run = (const int*)oc_segvector_contiguous(vec, i, &n);
+    ASSERT(run && n > 0, "Each run is non-empty");
+    for (size_t j = 0; j < n; ++j)
+      sum += run[j];
+    seen += n;
+    ++runs;
+  }
+  ASSERT_EQ(seen, (size_t)1000, "%zu", "Runs cover every element once");
+  ASSERT_EQ(sum, 999LL * 1000 / 2, "%lld", "Runs hold the elements in order");
+  // 16 + 32 + ... + 512 = 1008 covers 1000 elements in 6 blocks.
+  ASSERT_EQ(runs, (size_t)6, "%zu", "One run per block");
+  ASSERT(oc_segvector_contiguous(vec, 1000, &n) == NULL && n == 0,
+         "A run past the end is empty");
+  oc_segvector_destroy(vec);
+}
+
+void test_reserve_and_allocator() {
+  printf("--- Testing Reserve and a Custom Allocator ---\n");
+  counter_t c = {0, 0, 0};
+  oc_allocator_t allocator = {counting_alloc, NULL, counting_free, &c};
+  oc_segvector_t* vec =
+      oc_segvector_create_with_allocator(sizeof(double), &allocator);
+  ASSERT_EQ(c.allocs, (size_t)1, "%zu", "The struct comes from the allocator");
+
+  ASSERT_EQ(oc_segvector_reserve(vec, 1000), OC_SUCCESS, "%d",
+            "Reserve succeeds");
+  ASSERT(oc_segvector_capacity(vec) >= 1000, "Reserve covers the request");
+  size_t allocs = c.allocs;
+  for (int i = 0; i < 1000; ++i) {
+    double d = i;
+    oc_segvector_push_back(vec, &d);
+  }
+  ASSERT_EQ(c.allocs, allocs, "%zu", "Reserved pushes allocate nothing");
+
+  oc_segvector_destroy(vec);
+  ASSERT_EQ(c.frees, c.allocs, "%zu", "Every block is freed");
+  ASSERT_EQ(c.live_bytes, (size_t)0, "%zu", "Freed sizes match allocations");
+}
+
+// --- Main Test Runner ---
+
+int main(void) {
+  printf("--- Running OmniC Segmented Vector Test Suite ---\n\n");
+
+  test_push_and_get();
+  test_stable_addresses();
+  test_append_and_runs();
+  test_reserve_and_allocator();
+
+  printf("\n--- Test Suite Finished ---\n");
+  if (g_test_failures == 0) {
+    printf("Result: ALL TESTS PASSED\n");
+    return EXIT_SUCCESS;
+  }
+
+  printf("Result: %d TEST(S) FAILED\n", g_test_failures);
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,873 @@
+// -*- mode: C; indent-tabs-mode: nil; c-basic-offset: 2; tab-width: 2; -*-
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <omnic/macros.h>
+#include <omnic/sorting.h>
+#include <omnic/sortnet.h>
+
+// --- Test Framework Setup ---
+
+// Global counter for failed tests
+static int g_test_failures = 0;
+
+typedef void (*sort_func_t)(oc_sort_list_t*);
+
+static void merge_parallel_4(oc_sort_list_t* list) {
+  oc_sort_merge_parallel(list, 4);
+}
+
+static void sample_parallel_4(oc_sort_list_t* list) {
+  oc_sort_sample_parallel(list, 4);
+}
+
+static void merge_in_place(oc_sort_list_t* list) {
+  oc_sort_merge_in_place(list, 0);
+}
+
+static void sort_auto(oc_sort_list_t* list) {
+  oc_sort_auto(list);
+}
+
+typedef struct {
+  const char* name;
+  sort_func_t func;
+  bool stable;  // Equal keys keep their input order
+} algorithm_t;
+
+static const algorithm_t ALGORITHMS[] = {
+    {"Selection Sort", oc_sort_selection, false},
+    {"Insertion Sort", oc_sort_insertion, true},
+    {"Bubble Sort", oc_sort_bubble, true},
+    {"Quick Sort", oc_sort_quick, false},
+    {"Pdqsort", oc_sort_pdq, false},
+    {"Merge Sort", oc_sort_merge, true},
+    {"Bottom-up Merge Sort", oc_sort_merge_bottom_up, true},
+    {"In-place Merge Sort", merge_in_place, true},
+    {"Parallel Merge Sort", merge_parallel_4, true},
+    {"Parallel Sample Sort", sample_parallel_4, false},
+    {"Timsort", oc_sort_tim, true},
+    {"Heap Sort", oc_sort_heap, false},
+    {"D-ary Heap Sort", oc_sort_heap_dary, false},
+    {"Radix Sort", oc_sort_radix, true},
+    {"Counting Sort", oc_sort_counting, true},
+    {"Auto Sort", sort_auto, false},
+    {NULL, NULL, false}};
+
+// --- Input Generators ---
+
+typedef enum {
+  INPUT_RANDOM,
+  INPUT_SORTED,
+  INPUT_REVERSED,
+  INPUT_FEW_UNIQUE,
+  INPUT_ALL_EQUAL,
+  INPUT_NEGATIVE,
+  INPUT_NEARLY_SORTED,
+  INPUT_COUNT
+} input_kind_t;
+
+static const char* INPUT_NAMES[INPUT_COUNT] = {
+    "random",    "sorted",   "reversed",     "few-unique",
+    "all-equal", "negative", "nearly-sorted"};
+
+// The payload records the original position so stability and payload
+// integrity can be checked after sorting.
+static void fill_input(oc_sort_entry_t* d, size_t n, input_kind_t kind) {
+  for (size_t i = 0; i < n; ++i) {
+    switch (kind) {
+      case INPUT_RANDOM:
+        d[i].key = rand();
+        break;
+      case INPUT_SORTED:
+        d[i].key = (oc_key_type_t)i;
+        break;
+      case INPUT_REVERSED:
+        d[i].key = (oc_key_type_t)(n - i);
+        break;
+      case INPUT_FEW_UNIQUE:
+        d[i].key = rand() % 4;
+        break;
+      case INPUT_ALL_EQUAL:
+        d[i].key = 7;
+        break;
+      case INPUT_NEGATIVE:
+        d[i].key = rand() - RAND_MAX / 2;
+        break;
+      case INPUT_NEARLY_SORTED:
+        // Sorted head with a few stray keys and a random appended tail.
+        d[i].key = i < n - n / 16 && rand() % 64 ? (oc_key_type_t)i : rand();
+        break;
+      default:
+        break;
+    }
+    d[i].data = (oc_data_type_t)i;
+  }
+}
+
+// Returns true if `out` is a sorted permutation of `in` (entries matched by
+// their payload), and, if requested, equal keys appear in input order.
+static bool check_sorted(const oc_sort_entry_t* in, const oc_sort_entry_t* out,
+                         size_t n, bool stable) {
+  bool* seen = (bool*)calloc(n ? n : 1, sizeof(bool));
+  bool ok = seen != NULL;
+  for (size_t i = 0; ok && i < n; ++i) {
+    size_t origin = (size_t)out[i].data;
+    if (origin >= n || seen[origin] || in[origin].key != out[i].key) {
+      ok = false;
+      break;
+    }
+    seen[origin] = true;
+    if (i > 0) {
+      if (out[i - 1].key > out[i].key) {
+        ok = false;
+      } else if (stable && out[i - 1].key == out[i].key &&
+                 out[i - 1].data > out[i].data) {
+        ok = false;
+      }
+    }
+  }
+  free(seen);
+  return ok;
+}
+
+// --- Test Functions ---
+
+void test_small_lists() {
+  printf("--- Testing Empty and Single-Element Lists ---\n");
+  oc_sort_entry_t one = {42, 0};
+
+  for (size_t a = 0; ALGORITHMS[a].name != NULL; ++a) {
+    oc_sort_list_t empty = oc_sort_list_view(NULL, 0);
+    ALGORITHMS[a].func(&empty);
+    ASSERT_EQ(empty.n, (size_t)0, "%zu", "Empty list should stay empty");
+
+    oc_sort_list_t single = oc_sort_list_view(&one, 1);
+    ALGORITHMS[a].func(&single);
+    ASSERT_EQ(one.key, 42, "%d", "Single element should be untouched");
+  }
+}
+
+void test_distributions() {
+  printf("--- Testing Input Distributions ---\n");
+  static const size_t SIZES[] = {2, 3, 17, 100, 1000, 5000};
+  const size_t num_sizes = sizeof(SIZES) / sizeof(SIZES[0]);
+  const size_t max_n = SIZES[num_sizes - 1];
+
+  oc_sort_entry_t* input =
+      (oc_sort_entry_t*)malloc(max_n * sizeof(oc_sort_entry_t));
+  oc_sort_entry_t* work =
+      (oc_sort_entry_t*)malloc(max_n * sizeof(oc_sort_entry_t));
+  ASSERT(input && work, "Buffer allocation should succeed");
+  if (!input || !work) {
+    free(input);
+    free(work);
+    return;
+  }
+
+  for (size_t s = 0; s < num_sizes; ++s) {
+    size_t n = SIZES[s];
+    for (int kind = 0; kind < INPUT_COUNT; ++kind) {
+      fill_input(input, n, (input_kind_t)kind);
+      for (size_t a = 0; ALGORITHMS[a].name != NULL; ++a) {
+        memcpy(work, input, n * sizeof(oc_sort_entry_t));
+        oc_sort_list_t list = oc_sort_list_view(work, n);
+        ALGORITHMS[a].func(&list);
+        if (!check_sorted(input, work, n, ALGORITHMS[a].stable)) {
+          fprintf(stderr, "      %s on %s input, n=%zu\n", ALGORITHMS[a].name,
+                  INPUT_NAMES[kind], n);
+          ASSERT(false, "List should be sorted with its payload attached");
+        }
+      }
+    }
+  }
+
+  free(input);
+  free(work);
+}
+
+void test_scalar_base_cases() {
+  printf("--- Testing Without the SIMD Network ---\n");
+  // Small ranges then go to insertion sort with the shorter cutoffs.
+  oc_sortnet_set_simd(false);
+  test_distributions();
+  oc_sortnet_set_simd(true);
+}
+
+void test_view_in_place() {
+  printf("--- Testing In-Place Sort of a Sub-Range ---\n");
+  // Sorting a view must only touch the viewed range of the caller's buffer.
+  oc_sort_entry_t buf[8] = {{9, 0}, {5, 1}, {4, 2}, {3, 3},
+                            {2, 4}, {1, 5}, {0, 6}, {-1, 7}};
+
+  for (size_t a = 0; ALGORITHMS[a].name != NULL; ++a) {
+    oc_sort_entry_t copy[8];
+    memcpy(copy, buf, sizeof(buf));
+    oc_sort_list_t list = oc_sort_list_view(copy + 1, 6);
+    ALGORITHMS[a].func(&list);
+    ASSERT_EQ(copy[0].key, 9, "%d", "Element before the view is untouched");
+    ASSERT_EQ(copy[7].key, -1, "%d", "Element after the view is untouched");
+    ASSERT_EQ(copy[1].key, 0, "%d", "View should start with the minimum");
+    ASSERT_EQ(copy[6].key, 5, "%d", "View should end with the maximum");
+  }
+}
+
+void test_quick_adversarial() {
+  printf("--- Testing Quick Sorts on Adversarial Inputs ---\n");
+  // Pre-sorted and duplicate-heavy inputs used to go quadratic and recurse
+  // n frames deep; at this size that would overflow the stack.
+  static const sort_func_t QUICK_SORTS[] = {oc_sort_quick, oc_sort_pdq};
+  const size_t n = (size_t)1 << 20;
+  oc_sort_entry_t* input =
+      (oc_sort_entry_t*)malloc(n * sizeof(oc_sort_entry_t));
+  oc_sort_entry_t* work =
+      (oc_sort_entry_t*)malloc(n * sizeof(oc_sort_entry_t));
+  ASSERT(input && work, "Buffer allocation should succeed");
+  if (!input || !work) {
+    free(input);
+    free(work);
+    return;
+  }
+
+  const size_t num_quick = sizeof(QUICK_SORTS) / sizeof(QUICK_SORTS[0]);
+  for (int kind = INPUT_SORTED; kind <= INPUT_ALL_EQUAL; ++kind) {
+    fill_input(input, n, (input_kind_t)kind);
+    for (size_t q = 0; q < num_quick; ++q) {
+      memcpy(work, input, n * sizeof(oc_sort_entry_t));
+      oc_sort_list_t list = oc_sort_list_view(work, n);
+      QUICK_SORTS[q](&list);
+      ASSERT(check_sorted(input, work, n, false),
+             "Quick sort should handle adversarial input");
+    }
+  }
+
+  // Organ pipe: ascending then descending.
+  for (size_t i = 0; i < n; ++i) {
+    input[i].key = (oc_key_type_t)(i < n / 2 ? i : n - i);
+    input[i].data = (oc_data_type_t)i;
+  }
+  for (size_t q = 0; q < num_quick; ++q) {
+    memcpy(work, input, n * sizeof(oc_sort_entry_t));
+    oc_sort_list_t list = oc_sort_list_view(work, n);
+    QUICK_SORTS[q](&list);
+    ASSERT(check_sorted(input, work, n, false),
+           "Quick sort should handle organ-pipe input");
+  }
+
+  free(input);
+  free(work);
+}
+
+void test_heap_dary_offsets() {
+  printf("--- Testing 4-ary Heap Sort at Every Alignment ---\n");
+  // The heap skips up to three leading entries to align its sibling groups
+  // and inserts them at the end; each start offset skips a different count.
+  static const size_t SIZES[] = {2, 3, 4, 5, 17, 1000};
+  oc_sort_entry_t input[1000];
+  _Alignas(32) oc_sort_entry_t work[1000 + 4];
+  for (size_t offset = 0; offset < 4; ++offset) {
+    for (size_t s = 0; s < sizeof(SIZES) / sizeof(SIZES[0]); ++s) {
+      size_t n = SIZES[s];
+      fill_input(input, n, INPUT_FEW_UNIQUE);
+      memcpy(work + offset, input, n * sizeof(oc_sort_entry_t));
+      oc_sort_list_t list = oc_sort_list_view(work + offset, n);
+      oc_sort_heap_dary(&list);
+      ASSERT(check_sorted(input, work + offset, n, false),
+             "4-ary heap sort should sort any start offset");
+    }
+  }
+}
+
+void test_merge_parallel() {
+  printf("--- Testing Parallel Merge Sort ---\n");
+  // Odd size and thread counts so chunks, merge rounds and slices are uneven.
+  static const unsigned THREADS[] = {2, 3, 5, 8, 0};
+  const size_t n = ((size_t)1 << 20) + 7;
+  oc_sort_entry_t* input =
+      (oc_sort_entry_t*)malloc(n * sizeof(oc_sort_entry_t));
+  oc_sort_entry_t* work =
+      (oc_sort_entry_t*)malloc(n * sizeof(oc_sort_entry_t));
+  ASSERT(input && work, "Buffer allocation should succeed");
+  if (!input || !work) {
+    free(input);
+    free(work);
+    return;
+  }
+
+  for (int kind = 0; kind < INPUT_COUNT; ++kind) {
+    fill_input(input, n, (input_kind_t)kind);
+    for (size_t t = 0; t < sizeof(THREADS) / sizeof(THREADS[0]); ++t) {
+      memcpy(work, input, n * sizeof(oc_sort_entry_t));
+      oc_sort_list_t list = oc_sort_list_view(work, n);
+      oc_sort_merge_parallel(&list, THREADS[t]);
+      if (!check_sorted(input, work, n, true)) {
+        fprintf(stderr, "      %s input, %u threads\n", INPUT_NAMES[kind],
+                THREADS[t]);
+        ASSERT(false, "Parallel merge sort should be sorted and stable");
+      }
+    }
+  }
+
+  free(input);
+  free(work);
+}
+
+void test_sample_parallel() {
+  printf("--- Testing Parallel Sample Sort ---\n");
+  // Uneven blocks, and sizes around the smallest that splits into buckets.
+  static const unsigned THREADS[] = {2, 3, 5, 8, 0};
+  static const size_t SIZES[] = {32768, 100003, ((size_t)1 << 20) + 7};
+  const size_t max_n = SIZES[2];
+  oc_sort_entry_t* input =
+      (oc_sort_entry_t*)malloc(max_n * sizeof(oc_sort_entry_t));
+  oc_sort_entry_t* work =
+      (oc_sort_entry_t*)malloc(max_n * sizeof(oc_sort_entry_t));
+  ASSERT(input && work, "Buffer allocation should succeed");
+  if (!input || !work) {
+    free(input);
+    free(work);
+    return;
+  }
+
+  for (size_t s = 0; s < sizeof(SIZES) / sizeof(SIZES[0]); ++s) {
+    size_t n = SIZES[s];
+    for (int kind = 0; kind < INPUT_COUNT; ++kind) {
+      fill_input(input, n, (input_kind_t)kind);
+      for (size_t t = 0; t < sizeof(THREADS) / sizeof(THREADS[0]); ++t) {
+        memcpy(work, input, n * sizeof(oc_sort_entry_t));
+        oc_sort_list_t list = oc_sort_list_view(work, n);
+        oc_sort_sample_parallel(&list, THREADS[t]);
+        if (!check_sorted(input, work, n, false)) {
+          fprintf(stderr, "      %s input, n=%zu, %u threads\n",
+                  INPUT_NAMES[kind], n, THREADS[t]);
+          ASSERT(false, "Parallel sample sort should sort every input");
+        }
+      }
+    }
+  }
+
+  free(input);
+  free(work);
+}
+
+void test_merge_in_place() {
+  printf("--- Testing In-place Merge Sort ---\n");
+  // No buffer, the stack buffer, a sqrt(n)-sized one, and more than needed.
+  static const size_t BUFFERS[] = {0, 256, 317, (size_t)1 << 20};
+  const size_t n = 100003;
+  oc_sort_entry_t* input =
+      (oc_sort_entry_t*)malloc(n * sizeof(oc_sort_entry_t));
+  oc_sort_entry_t* work =
+      (oc_sort_entry_t*)malloc(n * sizeof(oc_sort_entry_t));
+  ASSERT(input && work, "Buffer allocation should succeed");
+  if (!input || !work) {
+    free(input);
+    free(work);
+    return;
+  }
+
+  for (int kind = 0; kind < INPUT_COUNT; ++kind) {
+    fill_input(input, n, (input_kind_t)kind);
+    for (size_t b = 0; b < sizeof(BUFFERS) / sizeof(BUFFERS[0]); ++b) {
+      memcpy(work, input, n * sizeof(oc_sort_entry_t));
+      oc_sort_list_t list = oc_sort_list_view(work, n);
+      oc_error_code_t err = oc_sort_merge_in_place(&list, BUFFERS[b]);
+      if (err != OC_SUCCESS || !check_sorted(input, work, n, true)) {
+        fprintf(stderr, "      %s input, %zu-entry buffer\n",
+                INPUT_NAMES[kind], BUFFERS[b]);
+        ASSERT(false, "In-place merge sort should be sorted and stable");
+      }
+    }
+  }
+
+  // A buffer that cannot be allocated is reported before anything moves.
+  oc_sort_list_t huge = oc_sort_list_view(work, (size_t)-1 / 32);
+  ASSERT_EQ(oc_sort_merge_in_place(&huge, (size_t)-1), OC_ERROR_ALLOC, "%d",
+            "An impossible buffer should be reported");
+
+  free(input);
+  free(work);
+}
+
+void test_tim_runs() {
+  printf("--- Testing Timsort on Run-Structured Inputs ---\n");
+  // Alternating ascending/descending runs of random length with few distinct
+  // keys exercise run reversal, galloping and both merge directions.
+  const size_t n = 300000;
+  oc_sort_entry_t* input =
+      (oc_sort_entry_t*)malloc(n * sizeof(oc_sort_entry_t));
+  oc_sort_entry_t* work =
+      (oc_sort_entry_t*)malloc(n * sizeof(oc_sort_entry_t));
+  ASSERT(input && work, "Buffer allocation should succeed");
+  if (!input || !work) {
+    free(input);
+    free(work);
+    return;
+  }
+
+  for (int round = 0; round < 8; ++round) {
+    int modulo = round % 2 ? 1000 : RAND_MAX;
+    size_t i = 0;
+    while (i < n) {
+      size_t len = 1 + (size_t)rand() % (round < 4 ? 5000 : 50);
+      int descending = rand() % 2;
+      oc_key_type_t key = rand() % modulo;
+      for (size_t r = 0; r < len && i < n; ++r, ++i) {
+        input[i].key = key;
+        input[i].data = (oc_data_type_t)i;
+        key += descending ? -(rand() % 3) : rand() % 3;
+      }
+    }
+    memcpy(work, input, n * sizeof(oc_sort_entry_t));
+    oc_sort_list_t list = oc_sort_list_view(work, n);
+    oc_sort_tim(&list);
+    ASSERT(check_sorted(input, work, n, true),
+           "Timsort should sort run-structured input stably");
+  }
+
+  free(input);
+  free(work);
+}
+
+// Streams a span in blocks for oc_sort_merge_k_stream().
+typedef struct {
+  const oc_sort_entry_t* d;
+  size_t n;
+  size_t pos;
+  bool fail;  // Report an error instead of data
+} span_source_t;
+
+static oc_error_code_t span_read(void* ctx, oc_sort_entry_t* buf, size_t cap,
+                                 size_t* got) {
+  span_source_t* s = (span_source_t*)ctx;
+  if (s->fail)
+    return OC_ERROR_IO;
+  *got = s->n - s->pos < cap ? s->n - s->pos : cap;
+  memcpy(buf, s->d + s->pos, *got * sizeof(oc_sort_entry_t));
+  s->pos += *got;
+  return OC_SUCCESS;
+}
+
+static oc_error_code_t list_write(void* ctx, const oc_sort_entry_t* d,
+                                  size_t n) {
+  oc_sort_list_t* out = (oc_sort_list_t*)ctx;
+  memcpy(out->d + out->n, d, n * sizeof(oc_sort_entry_t));
+  out->n += n;
+  return OC_SUCCESS;
+}
+
+void test_merge_k() {
+  printf("--- Testing K-way Merge ---\n");
+  static const size_t KS[] = {0, 1, 2, 3, 7, 64, 200};
+  const size_t n = 100000;
+  oc_sort_entry_t* input =
+      (oc_sort_entry_t*)malloc(n * sizeof(oc_sort_entry_t));
+  oc_sort_entry_t* work =
+      (oc_sort_entry_t*)malloc(n * sizeof(oc_sort_entry_t));
+  oc_sort_entry_t* out = (oc_sort_entry_t*)malloc(n * sizeof(oc_sort_entry_t));
+  oc_sort_list_t* runs = (oc_sort_list_t*)malloc(200 * sizeof(oc_sort_list_t));
+  oc_sort_source_t* sources =
+      (oc_sort_source_t*)malloc(200 * sizeof(oc_sort_source_t));
+  span_source_t* spans = (span_source_t*)malloc(200 * sizeof(span_source_t));
+  ASSERT(input && work && out && runs && sources && spans,
+         "Buffer allocation should succeed");
+  if (!input || !work || !out || !runs || !sources || !spans) {
+    free(input);
+    free(work);
+    free(out);
+    free(runs);
+    free(sources);
+    free(spans);
+    return;
+  }
+
+  bool ok = true, stream_ok = true;
+  for (int kind = 0; kind < INPUT_COUNT; ++kind) {
+    for (size_t q = 0; q < sizeof(KS) / sizeof(KS[0]); ++q) {
+      size_t k = KS[q];
+      size_t len = k ? n : 0;
+      fill_input(input, len, (input_kind_t)kind);
+      memcpy(work, input, len * sizeof(oc_sort_entry_t));
+
+      // Cut the input into k sorted runs of random (possibly zero) length.
+      size_t start = 0;
+      for (size_t i = 0; i < k; ++i) {
+        size_t left = len - start;
+        size_t run = i + 1 == k ? left : (size_t)rand() % (2 * len / k + 1);
+        if (run > left)
+          run = left;
+        runs[i] = oc_sort_list_view(work + start, run);
+        oc_sort_merge(&runs[i]);
+        start += run;
+      }
+
+      oc_sort_list_t dst = oc_sort_list_view(out, n);
+      ok = ok && oc_sort_merge_k(runs, k, &dst) == OC_SUCCESS &&
+           dst.n == len && check_sorted(input, out, len, true);
+
+      // Same runs as streams, through a deliberately small buffer.
+      for (size_t i = 0; i < k; ++i) {
+        spans[i] = (span_source_t){runs[i].d, runs[i].n, 0, false};
+        sources[i] = (oc_sort_source_t){span_read, &spans[i]};
+      }
+      oc_sort_entry_t small[3 * 201];
+      dst = oc_sort_list_view(out, 0);
+      oc_sort_sink_t sink = {list_write, &dst};
+      stream_ok = stream_ok &&
+                  oc_sort_merge_k_stream(sources, k, &sink, small,
+                                         3 * (k + 1)) == OC_SUCCESS &&
+                  dst.n == len && check_sorted(input, out, len, true);
+    }
+  }
+  ASSERT(ok, "oc_sort_merge_k should merge runs stably");
+  ASSERT(stream_ok, "oc_sort_merge_k_stream should merge sources stably");
+
+  oc_sort_list_t short_out = oc_sort_list_view(out, 1);
+  ASSERT_EQ(oc_sort_merge_k(runs, 2, &short_out), OC_ERROR_INVALID_ARG, "%d",
+            "A too short output should be rejected");
+
+  // Source errors abort the merge; NULL buffers are allocated internally.
+  for (size_t i = 0; i < 3; ++i) {
+    spans[i] = (span_source_t){input, 10, 0, i == 2};
+    sources[i] = (oc_sort_source_t){span_read, &spans[i]};
+  }
+  oc_sort_list_t dst = oc_sort_list_view(out, 0);
+  oc_sort_sink_t sink = {list_write, &dst};
+  ASSERT_EQ(oc_sort_merge_k_stream(sources, 3, &sink, NULL, 0), OC_ERROR_IO,
+            "%d", "A failing source should abort the merge");
+
+  free(input);
+  free(work);
+  free(out);
+  free(runs);
+  free(sources);
+  free(spans);
+}
+
+void test_select_nth() {
+  printf("--- Testing Selection (nth element) ---\n");
+  static const size_t SIZES[] = {1, 2, 10, 65, 601, 5000, 100003};
+  const size_t max_n = 100003;
+  oc_sort_entry_t* input =
+      (oc_sort_entry_t*)malloc(max_n * sizeof(oc_sort_entry_t));
+  oc_sort_entry_t* sorted =
+      (oc_sort_entry_t*)malloc(max_n * sizeof(oc_sort_entry_t));
+  oc_sort_entry_t* work =
+      (oc_sort_entry_t*)malloc(max_n * sizeof(oc_sort_entry_t));
+  ASSERT(input && sorted && work, "Buffer allocation should succeed");
+  if (!input || !sorted || !work) {
+    free(input);
+    free(sorted);
+    free(work);
+    return;
+  }
+
+  bool ok = true;
+  for (size_t s = 0; s < sizeof(SIZES) / sizeof(SIZES[0]); ++s) {
+    size_t n = SIZES[s];
+    for (int kind = 0; kind < INPUT_COUNT; ++kind) {
+      fill_input(input, n, (input_kind_t)kind);
+      memcpy(sorted, input, n * sizeof(oc_sort_entry_t));
+      oc_sort_list_t ref = oc_sort_list_view(sorted, n);
+      oc_sort_merge(&ref);
+
+      const size_t ranks[] = {0, n / 3, n / 2, n - 1};
+      for (size_t r = 0; r < sizeof(ranks) / sizeof(ranks[0]); ++r) {
+        size_t nth = ranks[r];
+        memcpy(work, input, n * sizeof(oc_sort_entry_t));
+        oc_sort_list_t list = oc_sort_list_view(work, n);
+        ok = ok && oc_select_nth(&list, nth) == OC_SUCCESS &&
+             work[nth].key == sorted[nth].key;
+        for (size_t i = 0; ok && i < n; ++i)
+          ok = i < nth ? work[i].key <= work[nth].key
+                       : work[i].key >= work[nth].key;
+      }
+      if (!ok) {
+        printf("  n = %zu, input = %s\n", n, INPUT_NAMES[kind]);
+        break;
+      }
+    }
+  }
+  ASSERT(ok, "oc_select_nth should place the nth key and partition around it");
+
+  oc_sort_list_t list = oc_sort_list_view(work, 10);
+  ASSERT_EQ(oc_select_nth(&list, 10), OC_ERROR_OUT_OF_BOUNDS, "%d",
+            "oc_select_nth should reject nth >= n");
+
+  free(input);
+  free(sorted);
+  free(work);
+}
+
+void test_partial_and_topk() {
+  printf("--- Testing Partial Sort and Top-k ---\n");
+  const size_t n = 200000;
+  static const size_t KS[] = {0, 1, 2, 100, 4096, 200000, 300000};
+  oc_sort_entry_t* input =
+      (oc_sort_entry_t*)malloc(n * sizeof(oc_sort_entry_t));
+  oc_sort_entry_t* sorted =
+      (oc_sort_entry_t*)malloc(n * sizeof(oc_sort_entry_t));
+  oc_sort_entry_t* work =
+      (oc_sort_entry_t*)malloc(n * sizeof(oc_sort_entry_t));
+  ASSERT(input && sorted && work, "Buffer allocation should succeed");
+  if (!input || !sorted || !work) {
+    free(input);
+    free(sorted);
+    free(work);
+    return;
+  }
+
+  bool partial_ok = true, smallest_ok = true, largest_ok = true;
+  for (int kind = 0; kind < INPUT_COUNT; ++kind) {
+    fill_input(input, n, (input_kind_t)kind);
+    memcpy(sorted, input, n * sizeof(oc_sort_entry_t));
+    oc_sort_list_t ref = oc_sort_list_view(sorted, n);
+    oc_sort_merge(&ref);
+
+    for (size_t q = 0; q < sizeof(KS) / sizeof(KS[0]); ++q) {
+      size_t k = KS[q];
+      size_t kept = k < n ? k : n;
+
+      memcpy(work, input, n * sizeof(oc_sort_entry_t));
+      oc_sort_list_t list = oc_sort_list_view(work, n);
+      oc_sort_partial(&list, k);
+      for (size_t i = 0; partial_ok && i < kept; ++i)
+        partial_ok = work[i].key == sorted[i].key;
+
+      // The streaming heaps see the input once; work is their buffer.
+      oc_topk_t low = oc_topk_init(work, kept, false);
+      for (size_t i = 0; i < n; ++i)
+        oc_topk_push(&low, input[i]);
+      oc_sort_list_t top = oc_topk_finish(&low);
+      smallest_ok = smallest_ok && top.n == kept;
+      for (size_t i = 0; smallest_ok && i < kept; ++i)
+        smallest_ok = work[i].key == sorted[i].key &&
+                      input[work[i].data].key == work[i].key;
+
+      oc_topk_t high = oc_topk_init(work, kept, true);
+      for (size_t i = 0; i < n; ++i)
+        oc_topk_push(&high, input[i]);
+      top = oc_topk_finish(&high);
+      largest_ok = largest_ok && top.n == kept;
+      for (size_t i = 0; largest_ok && i < kept; ++i)
+        largest_ok = work[i].key == sorted[n - 1 - i].key &&
+                     input[work[i].data].key == work[i].key;
+    }
+  }
+  ASSERT(partial_ok, "oc_sort_partial should sort the k smallest keys");
+  ASSERT(smallest_ok, "Top-k should keep the smallest keys, ascending");
+  ASSERT(largest_ok, "Top-k should keep the largest keys, descending");
+
+  // Fewer pushes than k: everything is kept.
+  oc_topk_t topk = oc_topk_init(work, 10, true);
+  for (int i = 0; i < 3; ++i) {
+    oc_sort_entry_t e = {i, i};
+    oc_topk_push(&topk, e);
+  }
+  oc_sort_list_t top = oc_topk_finish(&topk);
+  ASSERT(top.n == 3 && work[0].key == 2 && work[2].key == 0,
+         "Top-k should return all entries when fewer than k were pushed");
+
+  free(input);
+  free(sorted);
+  free(work);
+}
+
+// A payload much wider than the key, tagged with its original position.
+typedef struct {
+  size_t origin;
+  char bytes[35];
+} wide_payload_t;
+
+static void fill_wide(wide_payload_t* v, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    v[i].origin = i;
+    memset(v[i].bytes, (int)(i % 251), sizeof(v[i].bytes));
+  }
+}
+
+static bool wide_matches(const wide_payload_t* v, size_t i, size_t origin) {
+  return v[i].origin == origin && v[i].bytes[0] == (char)(origin % 251) &&
+         v[i].bytes[sizeof(v[i].bytes) - 1] == (char)(origin % 251);
+}
+
+void test_index_and_kv() {
+  printf("--- Testing Index Sort and Key/Value Sort ---\n");
+  static const size_t SIZES[] = {0, 1, 2, 17, 100003};
+  const size_t max_n = SIZES[4];
+  oc_sort_entry_t* sorted =
+      (oc_sort_entry_t*)malloc(max_n * sizeof(oc_sort_entry_t));
+  oc_key_type_t* keys = (oc_key_type_t*)malloc(max_n * sizeof(oc_key_type_t));
+  size_t* perm = (size_t*)malloc(max_n * sizeof(size_t));
+  wide_payload_t* values =
+      (wide_payload_t*)malloc(max_n * sizeof(wide_payload_t));
+  ASSERT(sorted && keys && perm && values, "Buffer allocation should succeed");
+  if (!sorted || !keys || !perm || !values) {
+    free(sorted);
+    free(keys);
+    free(perm);
+    free(values);
+    return;
+  }
+
+  bool index_ok = true, apply_ok = true, kv_ok = true;
+  for (size_t s = 0; s < sizeof(SIZES) / sizeof(SIZES[0]); ++s) {
+    size_t n = SIZES[s];
+    for (int kind = 0; kind < INPUT_COUNT; ++kind) {
+      // The stable reference order: data holds the original position.
+      fill_input(sorted, n, (input_kind_t)kind);
+      for (size_t i = 0; i < n; ++i)
+        keys[i] = sorted[i].key;
+      oc_sort_list_t ref = oc_sort_list_view(sorted, n);
+      oc_sort_merge(&ref);
+
+      bool ok = oc_sort_index(keys, n, perm) == OC_SUCCESS;
+      for (size_t i = 0; ok && i < n; ++i)
+        ok = perm[i] == (size_t)sorted[i].data;
+      index_ok = index_ok && ok;
+
+      fill_wide(values, n);
+      ok = oc_sort_apply_permutation(values, n, sizeof(wide_payload_t),
+                                     perm) == OC_SUCCESS;
+      for (size_t i = 0; ok && i < n; ++i)
+        ok = wide_matches(values, i, perm[i]);
+      apply_ok = apply_ok && ok;
+
+      fill_wide(values, n);
+      ok = oc_sort_kv(keys, values, n, sizeof(wide_payload_t)) == OC_SUCCESS;
+      for (size_t i = 0; ok && i < n; ++i) {
+        ok = keys[i] == sorted[i].key &&
+             wide_matches(values, i, (size_t)sorted[i].data);
+      }
+      kv_ok = kv_ok && ok;
+      if (!index_ok || !apply_ok || !kv_ok) {
+        fprintf(stderr, "      %s input, n=%zu\n", INPUT_NAMES[kind], n);
+        break;
+      }
+    }
+  }
+  ASSERT(index_ok, "oc_sort_index should return the stable sort order");
+  ASSERT(apply_ok, "oc_sort_apply_permutation should gather by position");
+  ASSERT(kv_ok, "oc_sort_kv should sort keys and carry the values stably");
+
+  // Keys only, and argument checks.
+  keys[0] = 3;
+  keys[1] = -1;
+  ASSERT_EQ(oc_sort_kv(keys, NULL, 2, 0), OC_SUCCESS, "%d",
+            "Keys should sort without values");
+  ASSERT(keys[0] == -1 && keys[1] == 3, "Keys alone should be sorted");
+  ASSERT_EQ(oc_sort_kv(keys, NULL, 2, 8), OC_ERROR_INVALID_ARG, "%d",
+            "Missing values should be rejected");
+  ASSERT_EQ(oc_sort_index(NULL, 2, perm), OC_ERROR_INVALID_ARG, "%d",
+            "Missing keys should be rejected");
+  ASSERT_EQ(oc_sort_apply_permutation(values, 2, 0, perm),
+            OC_ERROR_INVALID_ARG, "%d", "A zero element size is invalid");
+
+  free(sorted);
+  free(keys);
+  free(perm);
+  free(values);
+}
+
+void test_auto_dispatch() {
+  printf("--- Testing Automatic Algorithm Selection ---\n");
+  const size_t n = 100000;
+  oc_sort_entry_t* input =
+      (oc_sort_entry_t*)malloc(n * sizeof(oc_sort_entry_t));
+  oc_sort_entry_t* work =
+      (oc_sort_entry_t*)malloc(n * sizeof(oc_sort_entry_t));
+  ASSERT(input && work, "Buffer allocation should succeed");
+  if (!input || !work) {
+    free(input);
+    free(work);
+    return;
+  }
+
+  // Expected path per input kind at this size.
+  static const oc_sort_path_t EXPECTED[INPUT_COUNT] = {
+      [INPUT_SORTED] = OC_SORT_PATH_NONE,
+      [INPUT_REVERSED] = OC_SORT_PATH_REVERSE,
+      [INPUT_FEW_UNIQUE] = OC_SORT_PATH_COUNTING,
+      [INPUT_ALL_EQUAL] = OC_SORT_PATH_NONE,
+      [INPUT_NEARLY_SORTED] = OC_SORT_PATH_PDQ};
+  for (int kind = 0; kind < INPUT_COUNT; ++kind) {
+    fill_input(input, n, (input_kind_t)kind);
+    memcpy(work, input, n * sizeof(oc_sort_entry_t));
+    oc_sort_list_t list = oc_sort_list_view(work, n);
+    oc_sort_plan_t plan = oc_sort_auto_plan(&list);
+    oc_sort_plan_t done = oc_sort_auto(&list);
+    printf("%-13s -> %s\n", INPUT_NAMES[kind], oc_sort_path_name(done.path));
+    ASSERT(check_sorted(input, work, n, false), "Auto sort should sort");
+    ASSERT_EQ(done.path, plan.path, "%d",
+              "The plan should predict the path taken");
+    if (kind == INPUT_RANDOM || kind == INPUT_NEGATIVE) {
+      ASSERT(done.path == OC_SORT_PATH_RADIX ||
+                 done.path == OC_SORT_PATH_PARALLEL,
+             "Large random inputs should be radix or parallel sorted");
+    } else {
+      ASSERT_EQ(done.path, EXPECTED[kind], "%d",
+                "Input characteristics should pick the expected path");
+    }
+  }
+
+  // The measurements themselves.
+  oc_sort_entry_t d[40];
+  for (size_t i = 0; i < 40; ++i) {
+    d[i].key = (int)(i % 10) - 5;
+    d[i].data = (int)i;
+  }
+  oc_sort_list_t list = oc_sort_list_view(d, 40);
+  oc_sort_plan_t plan = oc_sort_auto_plan(&list);
+  ASSERT(plan.n == 40 && plan.min_key == -5 && plan.max_key == 4,
+         "The plan should report the key range");
+  ASSERT(plan.descents == 3 && plan.ascents == 36,
+         "The plan should count out-of-order neighbours");
+  ASSERT_EQ(plan.path, OC_SORT_PATH_COUNTING, "%d",
+            "A range of 10 keys should be counting sorted");
+  list.n = 20;
+  ASSERT_EQ(oc_sort_auto_plan(&list).path, OC_SORT_PATH_INSERTION, "%d",
+            "Tiny lists should be insertion sorted");
+  list.n = 1;
+  ASSERT_EQ(oc_sort_auto(&list).path, OC_SORT_PATH_NONE, "%d",
+            "A single entry needs no sort");
+  ASSERT(strcmp(oc_sort_path_name(OC_SORT_PATH_RADIX), "radix") == 0,
+         "Paths should have names");
+
+  free(input);
+  free(work);
+}
+
+// --- Main Test Runner ---
+
+int main(void) {
+  printf("--- Running OmniC Sorting Test Suite ---\n\n");
+  srand(12345);
+
+  test_small_lists();
+  test_distributions();
+  test_scalar_base_cases();
+  test_view_in_place();
+  test_quick_adversarial();
+  test_heap_dary_offsets();
+  test_merge_parallel();
+  test_sample_parallel();
+  test_merge_in_place();
+  test_tim_runs();
+  test_merge_k();
+  test_select_nth();
+  test_partial_and_topk();
+  test_index_and_kv();
+  test_auto_dispatch();
+
+  printf("\n--- Test Suite Finished ---\n");
+  if (g_test_failures == 0) {
+    printf("Result: ALL TESTS PASSED\n");
+    return EXIT_SUCCESS;
+  }
+
+  printf("Result: %d TEST(S) FAILED\n", g_test_failures);
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,199 @@
+// -*- mode: C; indent-tabs-mode: nil; c-basic-offset: 2; tab-width: 2; -*-
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <omnic/macros.h>
+#include <omnic/sortnet.h>
+
+// --- Test Framework Setup ---
+
+// Global counter for failed tests
+static int g_test_failures = 0;
+
+// --- Helpers ---
+
+static int cmp_int(const void* a, const void* b) {
+  int x = *(const int*)a, y = *(const int*)b;
+  return (x > y) - (x < y);
+}
+
+// Orders by key, then by data (the order oc_sortnet_entries() produces).
+static int cmp_entry(const void* a, const void* b) {
+  const oc_sort_entry_t* x = (const oc_sort_entry_t*)a;
+  const oc_sort_entry_t* y = (const oc_sort_entry_t*)b;
+  if (x->key != y->key)
+    return (x->key > y->key) - (x->key < y->key);
+  return (x->data > y->data) - (x->data < y->data);
+}
+
+// Mixes small ranges (many ties) with the extreme values.
+static int random_key(int range) {
+  switch (rand() % 8) {
+    case 0:
+      return INT_MIN;
+    case 1:
+      return INT_MAX;
+    default:
+      return rand() % range - range / 2;
+  }
+}
+
+// --- Test Functions ---
+
+static void check_int_sizes(const char* mode) {
+  int d[OC_SORTNET_MAX], e[OC_SORTNET_MAX];
+  bool ok = true;
+  for (size_t n = 0; n <= OC_SORTNET_MAX && ok; ++n) {
+    for (int rep = 0; rep < 50 && ok; ++rep) {
+      for (size_t i = 0; i < n; ++i)
+        d[i] = random_key(rep % 2 ? 8 : 1 << 20);
+      memcpy(e, d, n * sizeof(int));
+      qsort(e, n, sizeof(int), cmp_int);
+      ok = oc_sortnet_int(d, n) == OC_SUCCESS &&
+           memcmp(d, e, n * sizeof(int)) == 0;
+    }
+    if (!ok)
+      printf("  n = %zu\n", n);
+  }
+  printf("Sizes 0..%d (%s)\n", OC_SORTNET_MAX, mode);
+  ASSERT(ok, "oc_sortnet_int should match qsort for every size");
+}
+
+static void check_entry_sizes(const char* mode) {
+  oc_sort_entry_t d[OC_SORTNET_MAX], e[OC_SORTNET_MAX], s[OC_SORTNET_MAX];
+  bool ok = true, stable = true;
+  for (size_t n = 0; n <= OC_SORTNET_MAX && ok && stable; ++n) {
+    for (int rep = 0; rep < 50 && ok && stable; ++rep) {
+      for (size_t i = 0; i < n; ++i) {
+        d[i].key = random_key(rep % 2 ? 4 : 1 << 20);
+        d[i].data = rand() % 3 ? (int)i : -(int)i;
+      }
+      memcpy(e, d, n * sizeof(oc_sort_entry_t));
+      memcpy(s, d, n * sizeof(oc_sort_entry_t));
+      qsort(e, n, sizeof(oc_sort_entry_t), cmp_entry);
+      ok = oc_sortnet_entries(d, n) == OC_SUCCESS &&
+           memcmp(d, e, n * sizeof(oc_sort_entry_t)) == 0;
+
+      // Tag the data with the input position to check stability.
+      for (size_t i = 0; i < n; ++i)
+        s[i].data = (int)i;
+      stable = oc_sortnet_entries_stable(s, n) == OC_SUCCESS;
+      for (size_t i = 0; i < n && stable; ++i)
+        stable = s[i].key == e[i].key &&
+                 (i == 0 || s[i - 1].key < s[i].key ||
+                  s[i - 1].data < s[i].data);
+    }
+    if (!ok || !stable)
+      printf("  n = %zu\n", n);
+  }
+  printf("Entry sizes 0..%d (%s)\n", OC_SORTNET_MAX, mode);
+  ASSERT(ok, "oc_sortnet_entries should sort by key, then data");
+  ASSERT(stable, "oc_sortnet_entries_stable should keep ties in order");
+}
+
+static void check_merge(const char* mode) {
+  static const size_t sizes[] = {0, 1, 7, 8, 9, 15, 16, 17, 64, 100, 1000};
+  const size_t count = sizeof(sizes) / sizeof(sizes[0]);
+  int* a = (int*)malloc(1000 * sizeof(int));
+  int* b = (int*)malloc(1000 * sizeof(int));
+  int* out = (int*)malloc(2000 * sizeof(int));
+  int* ref = (int*)malloc(2000 * sizeof(int));
+  ASSERT(a && b && out && ref, "Buffer allocation should succeed");
+  if (!a || !b || !out || !ref) {
+    free(a);
+    free(b);
+    free(out);
+    free(ref);
+    return;
+  }
+
+  bool ok = true;
+  for (size_t x = 0; x < count; ++x) {
+    for (size_t y = 0; y < count; ++y) {
+      size_t na = sizes[x], nb = sizes[y];
+      for (int rep = 0; rep < 4; ++rep) {
+        int range = rep % 2 ? 16 : 1 << 20;
+        for (size_t i = 0; i < na; ++i)
+          a[i] = random_key(range);
+        for (size_t i = 0; i < nb; ++i)
+          b[i] = random_key(range);
+        if (rep == 3) {
+          // Disjoint inputs: all of a below all of b.
+          for (size_t i = 0; i < na; ++i)
+            a[i] = (int)i;
+          for (size_t i = 0; i < nb; ++i)
+            b[i] = (int)(na + i);
+        }
+        qsort(a, na, sizeof(int), cmp_int);
+        qsort(b, nb, sizeof(int), cmp_int);
+        memcpy(ref, a, na * sizeof(int));
+        memcpy(ref + na, b, nb * sizeof(int));
+        qsort(ref, na + nb, sizeof(int), cmp_int);
+
+        oc_sortnet_merge_int(a, na, b, nb, out);
+        if (memcmp(out, ref, (na + nb) * sizeof(int)) != 0) {
+          printf("  na = %zu, nb = %zu\n", na, nb);
+          ok = false;
+        }
+      }
+    }
+  }
+  printf("Merge (%s)\n", mode);
+  ASSERT(ok, "oc_sortnet_merge_int should merge two sorted arrays");
+
+  free(a);
+  free(b);
+  free(out);
+  free(ref);
+}
+
+void test_kernels(const char* mode) {
+  printf("--- Testing %s kernels ---\n", mode);
+  check_int_sizes(mode);
+  check_entry_sizes(mode);
+  check_merge(mode);
+}
+
+void test_invalid_size() {
+  printf("--- Testing size limit ---\n");
+  int d[OC_SORTNET_MAX + 1] = {0};
+  oc_sort_entry_t e[OC_SORTNET_MAX + 1];
+  memset(e, 0, sizeof(e));
+  ASSERT_EQ(oc_sortnet_int(d, OC_SORTNET_MAX + 1), OC_ERROR_INVALID_ARG, "%d",
+            "oc_sortnet_int should reject n > OC_SORTNET_MAX");
+  ASSERT_EQ(oc_sortnet_entries(e, OC_SORTNET_MAX + 1), OC_ERROR_INVALID_ARG,
+            "%d", "oc_sortnet_entries should reject n > OC_SORTNET_MAX");
+  ASSERT_EQ(oc_sortnet_entries_stable(e, OC_SORTNET_MAX + 1),
+            OC_ERROR_INVALID_ARG, "%d",
+            "oc_sortnet_entries_stable should reject n > OC_SORTNET_MAX");
+}
+
+// --- Main Test Runner ---
+
+int main(void) {
+  printf("--- Running OmniC Sorting Network Test Suite ---\n\n");
+  srand(2024);
+
+  bool simd = oc_sortnet_simd_enabled();
+  test_kernels(simd ? "AVX2" : "scalar (no AVX2)");
+  if (simd) {
+    oc_sortnet_set_simd(false);
+    ASSERT(!oc_sortnet_simd_enabled(), "SIMD should be disabled on request");
+    test_kernels("scalar");
+    oc_sortnet_set_simd(true);
+  }
+  test_invalid_size();
+
+  printf("\n--- Test Suite Finished ---\n");
+  if (g_test_failures == 0) {
+    printf("Result: ALL TESTS PASSED\n");
+    return EXIT_SUCCESS;
+  }
+
+  printf("Result: %d TEST(S) FAILED\n", g_test_failures);
+  return EXIT_FAILURE;
+}
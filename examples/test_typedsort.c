@@ -0,0 +1,182 @@
+// -*- mode: C; indent-tabs-mode: nil; c-basic-offset: 2; tab-width: 2; -*-
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <omnic/macros.h>
+#include <omnic/typedsort.h>
+
+// --- Test Framework Setup ---
+
+// Global counter for failed tests
+static int g_test_failures = 0;
+
+// --- Instantiations ---
+
+typedef struct {
+  uint64_t hi;
+  uint64_t lo;
+} u128_t;
+
+typedef struct {
+  int32_t score;
+  uint32_t id;  // Input position, to check stability
+  char payload[40];
+} record_t;
+
+OC_SORT_DEFINE(i64, int64_t, *a < *b)
+OC_SORT_DEFINE(f64, double, *a < *b)
+OC_SORT_DEFINE(u128, u128_t, a->hi < b->hi || (a->hi == b->hi && a->lo < b->lo))
+OC_SORT_DEFINE(str, const char*, strcmp(*a, *b) < 0)
+OC_SORT_DEFINE(rec, record_t, a->score < b->score)
+OC_SORT_DEFINE(desc, int, *a > *b)
+
+// --- Helpers ---
+
+static uint64_t rand64(void) {
+  return ((uint64_t)rand() << 42) ^ ((uint64_t)rand() << 21) ^
+         (uint64_t)rand();
+}
+
+// --- Test Functions ---
+
+void test_int64() {
+  printf("--- Testing int64_t ---\n");
+  const size_t n = 200000;
+  int64_t* d = (int64_t*)malloc(n * sizeof(int64_t));
+  int64_t* e = (int64_t*)malloc(n * sizeof(int64_t));
+  ASSERT(d && e, "Buffer allocation should succeed");
+  if (!d || !e) {
+    free(d);
+    free(e);
+    return;
+  }
+
+  for (size_t i = 0; i < n; ++i)
+    d[i] = (int64_t)rand64();
+  memcpy(e, d, n * sizeof(int64_t));
+  i64_sort(d, n);
+  ASSERT(i64_is_sorted(d, n), "Introsort should sort int64_t");
+  ASSERT_EQ(i64_sort_merge(e, n), OC_SUCCESS, "%d", "Merge sort succeeds");
+  ASSERT(memcmp(d, e, n * sizeof(int64_t)) == 0,
+         "Introsort and merge sort should agree");
+  memcpy(e, d, n * sizeof(int64_t));
+  i64_sort_heap(e, n);
+  ASSERT(memcmp(d, e, n * sizeof(int64_t)) == 0,
+         "Heap sort should agree with introsort");
+
+  // Sorted and all-equal inputs must not degrade.
+  i64_sort(d, n);
+  ASSERT(i64_is_sorted(d, n), "Sorting sorted input keeps it sorted");
+  for (size_t i = 0; i < n; ++i)
+    d[i] = 5;
+  i64_sort(d, n);
+  ASSERT(i64_is_sorted(d, n), "All-equal input should sort");
+
+  free(d);
+  free(e);
+}
+
+void test_double_and_descending() {
+  printf("--- Testing double and Reversed Ordering ---\n");
+  double d[1000];
+  int r[1000];
+  for (size_t i = 0; i < 1000; ++i) {
+    d[i] = (double)rand() / RAND_MAX - 0.5;
+    r[i] = rand() % 100;
+  }
+  f64_sort(d, 1000);
+  ASSERT(f64_is_sorted(d, 1000), "Introsort should sort doubles");
+  desc_sort_heap(r, 1000);
+  ASSERT(r[0] >= r[999], "Descending ordering should put the largest first");
+  ASSERT(desc_is_sorted(r, 1000), "Descending heap sort should be ordered");
+}
+
+void test_u128() {
+  printf("--- Testing 128-bit Composite Keys ---\n");
+  const size_t n = 50000;
+  u128_t* d = (u128_t*)malloc(n * sizeof(u128_t));
+  ASSERT(d != NULL, "Buffer allocation should succeed");
+  if (!d) {
+    return;
+  }
+  for (size_t i = 0; i < n; ++i) {
+    d[i].hi = (uint64_t)(rand() % 16);  // Many ties on the high word
+    d[i].lo = rand64();
+  }
+  u128_sort(d, n);
+  ASSERT(u128_is_sorted(d, n), "Introsort should sort 128-bit keys");
+  free(d);
+}
+
+void test_strings() {
+  printf("--- Testing String Pointers ---\n");
+  const char* words[] = {"pear", "apple", "fig",  "banana", "cherry",
+                         "kiwi", "date",  "lime", "apple",  "grape"};
+  const size_t n = sizeof(words) / sizeof(words[0]);
+  str_sort(words, n);
+  ASSERT(str_is_sorted(words, n), "Strings should sort lexicographically");
+  ASSERT(strcmp(words[0], "apple") == 0, "First word should be apple");
+  ASSERT(strcmp(words[n - 1], "pear") == 0, "Last word should be pear");
+}
+
+void test_stable_records() {
+  printf("--- Testing Stability on Wide Records ---\n");
+  const size_t n = 30000;
+  record_t* d = (record_t*)malloc(n * sizeof(record_t));
+  record_t* tmp = (record_t*)malloc(n * sizeof(record_t));
+  ASSERT(d && tmp, "Buffer allocation should succeed");
+  if (!d || !tmp) {
+    free(d);
+    free(tmp);
+    return;
+  }
+  for (size_t i = 0; i < n; ++i) {
+    d[i].score = rand() % 50;
+    d[i].id = (uint32_t)i;
+    snprintf(d[i].payload, sizeof(d[i].payload), "record-%zu", i);
+  }
+
+  rec_sort_merge_buf(d, n, tmp);
+  bool stable = true;
+  for (size_t i = 1; i < n; ++i) {
+    if (d[i - 1].score > d[i].score ||
+        (d[i - 1].score == d[i].score && d[i - 1].id > d[i].id)) {
+      stable = false;
+    }
+  }
+  ASSERT(stable, "Merge sort should be stable");
+
+  char expected[40];
+  snprintf(expected, sizeof(expected), "record-%u", d[n / 2].id);
+  ASSERT(strcmp(d[n / 2].payload, expected) == 0,
+         "Payload should move with its key");
+
+  free(d);
+  free(tmp);
+}
+
+// --- Main Test Runner ---
+
+int main(void) {
+  printf("--- Running OmniC Typed Sort Test Suite ---\n\n");
+  srand(2024);
+
+  test_int64();
+  test_double_and_descending();
+  test_u128();
+  test_strings();
+  test_stable_records();
+
+  printf("\n--- Test Suite Finished ---\n");
+  if (g_test_failures == 0) {
+    printf("Result: ALL TESTS PASSED\n");
+    return EXIT_SUCCESS;
+  }
+
+  printf("Result: %d TEST(S) FAILED\n", g_test_failures);
+  return EXIT_FAILURE;
+}
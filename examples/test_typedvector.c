@@ -0,0 +1,126 @@
+// -*- mode: C; indent-tabs-mode: nil; c-basic-offset: 2; tab-width: 2; -*-
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <omnic/macros.h>
+#include <omnic/typedvector.h>
+
+// --- Test Framework Setup ---
+
+// Global counter for failed tests
+static int g_test_failures = 0;
+
+// --- Instantiations ---
+
+typedef struct {
+  double x, y, z;
+} vec3_t;
+
+OC_VECTOR_DEFINE(ivec, int)
+OC_VECTOR_DEFINE(v3vec, vec3_t)
+
+// --- Test Functions ---
+
+void test_push_and_access() {
+  printf("--- Testing Push, At and Pop ---\n");
+  ivec_t v = {0};
+  ASSERT_EQ(ivec_size(&v), (size_t)0, "%zu", "Zeroed vector is empty");
+
+  for (int i = 0; i < 1000; ++i)
+    ASSERT_EQ(ivec_push(&v, i * 3), OC_SUCCESS, "%d", "Push should succeed");
+  ASSERT_EQ(ivec_size(&v), (size_t)1000, "%zu", "Size should be 1000");
+  ASSERT(v.capacity >= 1000, "Capacity should cover the size");
+
+  bool ok = true;
+  for (size_t i = 0; i < ivec_size(&v); ++i)
+    ok = ok && *ivec_at(&v, i) == (int)i * 3;
+  ASSERT(ok, "Elements should read back in push order");
+
+  *ivec_at_mut(&v, 5) = -1;
+  ASSERT_EQ(ivec_data(&v)[5], -1, "%d",
+            "at_mut() should return a writable slot");
+  const ivec_t* cv = &v;
+  ASSERT(ivec_at(cv, 5) == &v.data[5], "at() should read a const vector");
+  ASSERT_EQ(ivec_pop(&v), 999 * 3, "%d", "Pop returns the last element");
+  ASSERT_EQ(ivec_size(&v), (size_t)999, "%zu", "Pop shrinks the size");
+
+  size_t cap = v.capacity;
+  ivec_clear(&v);
+  ASSERT_EQ(ivec_size(&v), (size_t)0, "%zu", "Clear empties the vector");
+  ASSERT_EQ(v.capacity, cap, "%zu", "Clear keeps the capacity");
+
+  ivec_free(&v);
+  ASSERT(v.data == NULL && v.capacity == 0, "Free resets the vector");
+}
+
+void test_reserve_and_structs() {
+  printf("--- Testing Reserve and Struct Elements ---\n");
+  v3vec_t v;
+  v3vec_init(&v);
+  ASSERT_EQ(v3vec_reserve(&v, 100), OC_SUCCESS, "%d", "Reserve succeeds");
+  ASSERT_EQ(v.capacity, (size_t)100, "%zu", "Reserve sets the capacity");
+  vec3_t* data = v3vec_data(&v);
+  for (int i = 0; i < 100; ++i)
+    v3vec_push(&v, (vec3_t){i, 2.0 * i, 3.0 * i});
+  ASSERT(v3vec_data(&v) == data, "Pushes within the reserve do not move");
+  ASSERT(v3vec_at(&v, 99)->z == 297.0, "Struct fields read back");
+  ASSERT_EQ(v3vec_reserve(&v, 10), OC_SUCCESS, "%d", "Smaller reserve is OK");
+  ASSERT_EQ(v.capacity, (size_t)100, "%zu", "Reserve never shrinks");
+  v3vec_free(&v);
+}
+
+void test_opaque_interop() {
+  printf("--- Testing Conversion to and from oc_vector_t ---\n");
+  ivec_t v = {0};
+  for (int i = 0; i < 50; ++i)
+    ivec_push(&v, i);
+  int* data = v.data;
+
+  oc_vector_t* opaque = ivec_to_vector(&v);
+  ASSERT(opaque != NULL, "Conversion to oc_vector_t succeeds");
+  ASSERT(v.data == NULL && v.size == 0, "The typed vector is left empty");
+  ASSERT(oc_vector_data(opaque) == data, "The buffer moves without a copy");
+  ASSERT_EQ(oc_vector_size(opaque), (size_t)50, "%zu", "Size carries over");
+  ASSERT_EQ(*(const int*)oc_vector_get(opaque, 49), 49, "%d",
+            "Elements read back through the opaque API");
+
+  int extra = 50;
+  oc_vector_push_back(opaque, &extra);
+
+  ASSERT_EQ(v3vec_from_vector(&(v3vec_t){0}, opaque), OC_ERROR_INVALID_ARG,
+            "%d", "A different element size is rejected");
+  ASSERT_EQ(ivec_from_vector(&v, opaque), OC_SUCCESS, "%d",
+            "Conversion back succeeds");
+  ASSERT_EQ(ivec_size(&v), (size_t)51, "%zu", "Size carries back");
+  ASSERT_EQ(*ivec_at(&v, 50), 50, "%d", "Opaque pushes are visible");
+  ivec_free(&v);
+
+  // An empty typed vector converts to an empty, usable opaque vector.
+  opaque = ivec_to_vector(&v);
+  ASSERT(opaque != NULL && oc_vector_size(opaque) == 0,
+         "An empty vector converts too");
+  ASSERT_EQ(oc_vector_push_back(opaque, &extra), OC_SUCCESS, "%d",
+            "The converted vector can grow");
+  oc_vector_destroy(opaque);
+}
+
+// --- Main Test Runner ---
+
+int main(void) {
+  printf("--- Running OmniC Typed Vector Test Suite ---\n\n");
+
+  test_push_and_access();
+  test_reserve_and_structs();
+  test_opaque_interop();
+
+  printf("\n--- Test Suite Finished ---\n");
+  if (g_test_failures == 0) {
+    printf("Result: ALL TESTS PASSED\n");
+    return EXIT_SUCCESS;
+  }
+
+  printf("Result: %d TEST(S) FAILED\n", g_test_failures);
+  return EXIT_FAILURE;
+}
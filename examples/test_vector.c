@@ -1,16 +1,82 @@
 // -*- mode: C; indent-tabs-mode: nil; c-basic-offset: 2; tab-width: 2; -*-
 
-#include <omnic/vector.h>
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
-int main(void) {
+#include <omnic/macros.h>
+#include <omnic/vector.h>
+
+// --- Test Framework Setup ---
+
+// Global counter for failed tests
+static int g_test_failures = 0;
+
+// --- Helpers ---
+
+static int int_cmp(const void* a, const void* b) {
+  int x = *(const int*)a, y = *(const int*)b;
+  return (x > y) - (x < y);
+}
+
+// An element whose size is not a multiple of 8.
+typedef struct {
+  char name[11];
+  short rank;
+} record_t;
+
+static int record_cmp(const void* a, const void* b) {
+  const record_t *x = (const record_t*)a, *y = (const record_t*)b;
+  if (x->rank != y->rank)
+    return x->rank - y->rank;
+  return strcmp(x->name, y->name);
+}
+
+// An element too large for oc_vector_sort's stack temporary.
+typedef struct {
+  int key;
+  char pad[300];
+} blob_t;
+
+// A bump arena: frees are no-ops, memory is reclaimed all at once.
+typedef struct {
+  _Alignas(max_align_t) unsigned char bytes[1 << 16];
+  size_t used;
+  size_t allocs, frees;
+} arena_t;
+
+static void* arena_alloc(void* ctx, size_t size) {
+  arena_t* arena = (arena_t*)ctx;
+  size_t aligned = (size + _Alignof(max_align_t) - 1) &
+                   ~(_Alignof(max_align_t) - 1);
+  if (aligned > sizeof(arena->bytes) - arena->used)
+    return NULL;
+  void* p = arena->bytes + arena->used;
+  arena->used += aligned;
+  arena->allocs++;
+  return p;
+}
+
+static void arena_free(void* ctx, void* ptr, size_t size) {
+  (void)ptr;
+  (void)size;
+  ((arena_t*)ctx)->frees++;
+}
+
+// --- Example ---
+
+// The original walkthrough: push ten integers and print them back.
+void example_push_and_print() {
   printf("--- OmniC Vector Example ---\n");
 
   // Create a vector to hold integers
   oc_vector_t* int_vec = oc_vector_create(sizeof(int));
   if (!int_vec) {
     fprintf(stderr, "Failed to create vector.\n");
-    return 1;
+    g_test_failures++;
+    return;
   }
 
   printf("Vector created. Initial size: %zu, capacity: %zu\n",
@@ -37,7 +103,334 @@ int main(void) {
 
   // Clean up
   oc_vector_destroy(int_vec);
-  printf("Vector destroyed.\n");
+  printf("Vector destroyed.\n\n");
+}
+
+// --- Test Functions ---
+
+void test_push_and_get() {
+  printf("--- Testing Push and Get ---\n");
+  oc_vector_t* vec = oc_vector_create(sizeof(int));
+  ASSERT(vec != NULL, "Vector should be created");
+  ASSERT_EQ(oc_vector_size(vec), (size_t)0, "%zu", "Initial size is 0");
+  ASSERT(oc_vector_create(0) == NULL, "Zero-sized elements are rejected");
+
+  for (int i = 0; i < 10; ++i) {
+    int val = (i + 1) * 10;
+    ASSERT_EQ(oc_vector_push_back(vec, &val), OC_SUCCESS, "%d",
+              "Push should succeed");
+  }
+  ASSERT_EQ(oc_vector_size(vec), (size_t)10, "%zu", "Size should be 10");
+  ASSERT(oc_vector_capacity(vec) >= 10, "Capacity should cover the size");
+
+  bool ok = true;
+  for (size_t i = 0; i < oc_vector_size(vec); ++i) {
+    const int* val = (const int*)oc_vector_get(vec, i);
+    ok = ok && val && *val == (int)(i + 1) * 10;
+  }
+  ASSERT(ok, "Elements should read back in push order");
+  ASSERT(oc_vector_get(vec, 10) == NULL, "Out of bounds get returns NULL");
+
+  oc_vector_destroy(vec);
+}
+
+void test_bulk_operations() {
+  printf("--- Testing Bulk Operations ---\n");
+  // No inline buffer, so the capacity follows the heap buffer exactly.
+  oc_vector_t* vec = oc_vector_create_small(sizeof(int), 0);
+  int values[100];
+  for (int i = 0; i < 100; ++i)
+    values[i] = i;
+
+  ASSERT_EQ(oc_vector_reserve(vec, 1000), OC_SUCCESS, "%d",
+            "Reserve should succeed");
+  ASSERT_EQ(oc_vector_capacity(vec), (size_t)1000, "%zu",
+            "Reserve should set the capacity");
+  void* data = oc_vector_data(vec);
+  ASSERT_EQ(oc_vector_append_n(vec, values, 100), OC_SUCCESS, "%d",
+            "Append should succeed");
+  ASSERT(oc_vector_data(vec) == data, "Appending within the reserve keeps "
+                                      "the buffer");
+  ASSERT_EQ(oc_vector_reserve(vec, 10), OC_SUCCESS, "%d",
+            "A smaller reserve is a no-op");
+  ASSERT_EQ(oc_vector_capacity(vec), (size_t)1000, "%zu",
+            "Reserve should never shrink");
+
+  // Insert 3 elements at 10, then check the shifted layout.
+  int extra[3] = {-1, -2, -3};
+  ASSERT_EQ(oc_vector_insert_range(vec, 10, extra, 3), OC_SUCCESS, "%d",
+            "Range insert should succeed");
+  const int* d = (const int*)oc_vector_data(vec);
+  ASSERT_EQ(oc_vector_size(vec), (size_t)103, "%zu", "Size grows by 3");
+  ASSERT(d[9] == 9 && d[10] == -1 && d[12] == -3 && d[13] == 10 &&
+             d[102] == 99,
+         "Inserted range should sit before the shifted tail");
+  ASSERT_EQ(oc_vector_insert_range(vec, 104, extra, 1),
+            OC_ERROR_OUT_OF_BOUNDS, "%d", "Insert past the end is rejected");
+  ASSERT_EQ(oc_vector_insert_range(vec, 0, NULL, 1), OC_ERROR_INVALID_ARG,
+            "%d", "NULL elements are rejected");
+  ASSERT_EQ(oc_vector_append_n(vec, NULL, 0), OC_SUCCESS, "%d",
+            "Appending nothing is fine");
+
+  ASSERT_EQ(oc_vector_erase_range(vec, 10, 3), OC_SUCCESS, "%d",
+            "Range erase should succeed");
+  d = (const int*)oc_vector_data(vec);
+  bool ok = oc_vector_size(vec) == 100;
+  for (int i = 0; ok && i < 100; ++i)
+    ok = d[i] == i;
+  ASSERT(ok, "Erasing the inserted range restores the contents");
+  ASSERT_EQ(oc_vector_erase_range(vec, 90, 11), OC_ERROR_OUT_OF_BOUNDS, "%d",
+            "Erase past the end is rejected");
+  ASSERT_EQ(oc_vector_erase_range(vec, 90, 10), OC_SUCCESS, "%d",
+            "Erasing the tail succeeds");
+
+  // Grow with a fill value, then with zeros, then shrink.
+  int fill = 42;
+  ASSERT_EQ(oc_vector_resize(vec, 1500, &fill), OC_SUCCESS, "%d",
+            "Resize up should succeed");
+  d = (const int*)oc_vector_data(vec);
+  ok = d[89] == 89;
+  for (size_t i = 90; ok && i < 1500; ++i)
+    ok = d[i] == 42;
+  ASSERT(ok, "New elements should be copies of the fill value");
+  ASSERT_EQ(oc_vector_resize(vec, 1510, NULL), OC_SUCCESS, "%d",
+            "Resize with zero fill should succeed");
+  ASSERT_EQ(*(const int*)oc_vector_get(vec, 1509), 0, "%d",
+            "A NULL fill should zero the new elements");
+  ASSERT_EQ(oc_vector_resize(vec, 5, NULL), OC_SUCCESS, "%d",
+            "Resize down should succeed");
+  ASSERT_EQ(oc_vector_size(vec), (size_t)5, "%zu", "Size should drop to 5");
+  ASSERT(oc_vector_capacity(vec) >= 1510, "Resize down keeps the capacity");
+
+  ASSERT_EQ(oc_vector_shrink_to_fit(vec), OC_SUCCESS, "%d",
+            "Shrink should succeed");
+  ASSERT_EQ(oc_vector_capacity(vec), (size_t)5, "%zu",
+            "Shrink should fit the capacity to the size");
+  ASSERT_EQ(*(const int*)oc_vector_get(vec, 4), 4, "%d",
+            "Shrink keeps the elements");
+
+  ASSERT_EQ(oc_vector_resize(vec, 0, NULL), OC_SUCCESS, "%d",
+            "Clearing succeeds");
+  ASSERT_EQ(oc_vector_shrink_to_fit(vec), OC_SUCCESS, "%d",
+            "Shrinking an empty vector succeeds");
+  ASSERT_EQ(oc_vector_capacity(vec), (size_t)0, "%zu",
+            "An empty vector releases its buffer");
+  ASSERT_EQ(oc_vector_push_back(vec, &fill), OC_SUCCESS, "%d",
+            "Push after releasing the buffer reallocates");
+  ASSERT_EQ(*(const int*)oc_vector_get(vec, 0), 42, "%d",
+            "The pushed value reads back");
+
+  ASSERT(oc_vector_data(NULL) == NULL, "NULL vector has no data");
+  ASSERT_EQ(oc_vector_reserve(NULL, 1), OC_ERROR_INVALID_ARG, "%d",
+            "NULL vector is rejected");
+  oc_vector_destroy(vec);
+}
+
+void test_small_buffer() {
+  printf("--- Testing Inline Storage ---\n");
+  _Alignas(max_align_t) unsigned char storage[OC_VECTOR_INLINE_BYTES(
+      sizeof(int), 16)];
+  oc_vector_t* vec = oc_vector_init_inline(storage, sizeof(storage),
+                                           sizeof(int));
+  ASSERT((void*)vec == (void*)storage, "The vector lives in the storage");
+  ASSERT_EQ(oc_vector_capacity(vec), (size_t)16, "%zu",
+            "The inline capacity fills the storage");
+  ASSERT(oc_vector_init_inline(storage + 1, sizeof(storage) - 1,
+                               sizeof(int)) == NULL,
+         "Misaligned storage is rejected");
+  ASSERT(oc_vector_init_inline(storage, OC_VECTOR_HEADER_SIZE - 1,
+                               sizeof(int)) == NULL,
+         "Storage without room for the header is rejected");
+
+  for (int i = 0; i < 16; ++i)
+    oc_vector_push_back(vec, &i);
+  const unsigned char* data = (const unsigned char*)oc_vector_data(vec);
+  ASSERT(oc_vector_is_inline(vec) && data > storage &&
+             data < storage + sizeof(storage),
+         "Sixteen elements stay in the caller's storage");
+
+  int extra[10] = {16, 17, 18, 19, 20, 21, 22, 23, 24, 25};
+  ASSERT_EQ(oc_vector_append_n(vec, extra, 10), OC_SUCCESS, "%d",
+            "Outgrowing the inline buffer spills to the heap");
+  ASSERT(!oc_vector_is_inline(vec), "The elements are on the heap");
+  bool ok = oc_vector_size(vec) == 26;
+  for (size_t i = 0; ok && i < 26; ++i)
+    ok = *(const int*)oc_vector_get(vec, i) == (int)i;
+  ASSERT(ok, "Spilling keeps the elements");
+
+  // Shrinking back below the inline capacity returns to the storage.
+  oc_vector_erase_range(vec, 4, 22);
+  ASSERT_EQ(oc_vector_shrink_to_fit(vec), OC_SUCCESS, "%d", "Shrink works");
+  ASSERT(oc_vector_is_inline(vec), "A shrunk vector moves back inline");
+  ASSERT_EQ(oc_vector_capacity(vec), (size_t)16, "%zu",
+            "The capacity is the inline capacity again");
+  ASSERT_EQ(*(const int*)oc_vector_get(vec, 3), 3, "%d",
+            "Moving back keeps the elements");
+  oc_vector_destroy(vec);  // Frees nothing: the storage is ours
+
+  // Heap-allocated small vectors share one block with their elements.
+  vec = oc_vector_create_small(sizeof(double), 4);
+  ASSERT(oc_vector_is_inline(vec), "A new small vector starts inline");
+  ASSERT_EQ(oc_vector_capacity(vec), (size_t)4, "%zu", "Inline capacity");
+  for (int i = 0; i < 5; ++i) {
+    double d = i * 0.5;
+    oc_vector_push_back(vec, &d);
+  }
+  ASSERT(!oc_vector_is_inline(vec), "The fifth element spills");
+  ASSERT(*(const double*)oc_vector_get(vec, 4) == 2.0, "Spilled data reads");
+
+  // Releasing copies inline elements out to a heap buffer.
+  oc_vector_t* small = oc_vector_create(sizeof(int));
+  ASSERT(oc_vector_is_inline(small), "Default vectors start inline");
+  int seven = 7;
+  oc_vector_push_back(small, &seven);
+  void* released;
+  size_t size, capacity;
+  ASSERT_EQ(oc_vector_release(small, &released, &size, &capacity),
+            OC_SUCCESS, "%d", "Release of an inline vector succeeds");
+  ASSERT(released && size == 1 && capacity == 1 && *(int*)released == 7,
+         "Released inline elements are copied to the heap");
+  free(released);
+  oc_vector_destroy(vec);
+}
+
+void test_custom_allocator() {
+  printf("--- Testing a Custom Allocator ---\n");
+  static arena_t arena;
+  oc_allocator_t allocator = {arena_alloc, NULL, arena_free, &arena};
+
+  oc_vector_t* vec = oc_vector_create_with_allocator(sizeof(int), &allocator);
+  ASSERT(vec != NULL, "Creation through the arena succeeds");
+  ASSERT(oc_vector_allocator(vec) == &allocator, "The allocator is kept");
+  ASSERT_EQ(arena.allocs, (size_t)1, "%zu",
+            "The vector and its inline buffer take one block");
+  for (int i = 0; i < 1000; ++i)
+    ASSERT_EQ(oc_vector_push_back(vec, &i), OC_SUCCESS, "%d",
+              "Growth through the arena succeeds");
+  const unsigned char* data = (const unsigned char*)oc_vector_data(vec);
+  ASSERT(data >= arena.bytes && data < arena.bytes + sizeof(arena.bytes),
+         "The heap buffer comes from the arena");
+  bool ok = true;
+  for (int i = 0; ok && i < 1000; ++i)
+    ok = *(const int*)oc_vector_get(vec, (size_t)i) == i;
+  ASSERT(ok, "Elements survive growth without a realloc callback");
+
+  // Growing past the arena fails cleanly.
+  ASSERT_EQ(oc_vector_reserve(vec, 1 << 20), OC_ERROR_ALLOC, "%d",
+            "An exhausted arena reports OC_ERROR_ALLOC");
+  ASSERT_EQ(oc_vector_size(vec), (size_t)1000, "%zu",
+            "A failed reserve leaves the vector intact");
+
+  oc_vector_destroy(vec);
+  ASSERT_EQ(arena.allocs, arena.frees, "%zu",
+            "Every arena block is handed back");
+
+  vec = oc_vector_create(sizeof(int));
+  ASSERT(oc_vector_allocator(vec) == oc_allocator_default(),
+         "Default vectors report the default allocator");
+  oc_vector_destroy(vec);
+}
+
+void test_sort() {
+  printf("--- Testing Sort ---\n");
+  ASSERT_EQ(oc_vector_sort(NULL, int_cmp), OC_ERROR_INVALID_ARG, "%d",
+            "A NULL vector should be rejected");
+
+  static const size_t SIZES[] = {0, 1, 2, 17, 1000, 100000};
+  for (size_t s = 0; s < sizeof(SIZES) / sizeof(SIZES[0]); ++s) {
+    for (int pattern = 0; pattern < 4; ++pattern) {
+      size_t n = SIZES[s];
+      oc_vector_t* vec = oc_vector_create(sizeof(int));
+      long long sum = 0, sorted_sum = 0;
+      for (size_t i = 0; i < n; ++i) {
+        int v = pattern == 0   ? rand() % 1000
+                : pattern == 1 ? 7
+                : pattern == 2 ? (int)i
+                               : (int)(n - i);
+        oc_vector_push_back(vec, &v);
+        sum += v;
+      }
+      const void* before = oc_vector_get(vec, 0);
+      ASSERT_EQ(oc_vector_sort(vec, int_cmp), OC_SUCCESS, "%d",
+                "Sort should succeed");
+      ASSERT(oc_vector_get(vec, 0) == before,
+             "Sorting should not move the storage");
+      bool ok = oc_vector_size(vec) == n;
+      for (size_t i = 0; i < oc_vector_size(vec); ++i) {
+        int v = *(const int*)oc_vector_get(vec, i);
+        ok = ok && (i == 0 || *(const int*)oc_vector_get(vec, i - 1) <= v);
+        sorted_sum += v;
+      }
+      ASSERT(ok && sum == sorted_sum, "Vector should be sorted in place");
+      oc_vector_destroy(vec);
+    }
+  }
+
+  oc_vector_t* vec = oc_vector_create(sizeof(record_t));
+  ASSERT_EQ(oc_vector_sort(vec, NULL), OC_ERROR_INVALID_ARG, "%d",
+            "A NULL comparison should be rejected");
+  for (int i = 0; i < 500; ++i) {
+    record_t r;
+    memset(&r, 0, sizeof(r));
+    snprintf(r.name, sizeof(r.name), "r%03d", 499 - i);
+    r.rank = (short)(i % 7);
+    oc_vector_push_back(vec, &r);
+  }
+  oc_vector_sort(vec, record_cmp);
+  bool ok = true;
+  for (size_t i = 1; i < oc_vector_size(vec); ++i)
+    ok = ok && record_cmp(oc_vector_get(vec, i - 1), oc_vector_get(vec, i)) < 0;
+  ASSERT(ok, "Odd-sized records should sort by the comparison");
+  oc_vector_destroy(vec);
+
+  // Large elements take their temporary from the allocator; an exhausted
+  // arena forces the swap fallback.
+  static arena_t arena;
+  oc_allocator_t alloc = {arena_alloc, NULL, arena_free, &arena};
+  for (int exhausted = 0; exhausted < 2; ++exhausted) {
+    arena.used = 0;
+    vec = oc_vector_create_with_allocator(sizeof(blob_t), &alloc);
+    oc_vector_reserve(vec, 100);
+    for (int i = 0; i < 100; ++i) {
+      blob_t b;
+      memset(&b, i, sizeof(b));
+      b.key = (i * 37) % 100;
+      oc_vector_push_back(vec, &b);
+    }
+    if (exhausted)
+      arena.used = sizeof(arena.bytes);
+    ASSERT_EQ(oc_vector_sort(vec, int_cmp), OC_SUCCESS, "%d",
+              "Sorting large elements should succeed");
+    ok = true;
+    for (size_t i = 0; i < oc_vector_size(vec); ++i) {
+      const blob_t* b = (const blob_t*)oc_vector_get(vec, i);
+      ok = ok && b->key == (int)i && b->pad[299] == (char)((i * 73) % 100);
+    }
+    ASSERT(ok, "Large elements should move whole");
+    oc_vector_destroy(vec);
+  }
+}
+
+// --- Main Test Runner ---
+
+int main(void) {
+  example_push_and_print();
+
+  printf("--- Running OmniC Vector Test Suite ---\n\n");
+  srand(11);
+
+  test_push_and_get();
+  test_bulk_operations();
+  test_small_buffer();
+  test_custom_allocator();
+  test_sort();
+
+  printf("\n--- Test Suite Finished ---\n");
+  if (g_test_failures == 0) {
+    printf("Result: ALL TESTS PASSED\n");
+    return EXIT_SUCCESS;
+  }
 
-  return 0;
+  printf("Result: %d TEST(S) FAILED\n", g_test_failures);
+  return EXIT_FAILURE;
 }
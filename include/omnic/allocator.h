@@ -0,0 +1,97 @@
+// -*- mode: C; indent-tabs-mode: nil; c-basic-offset: 2; tab-width: 2; -*-
+
+#ifndef OMNIC_ALLOCATOR_H
+#define OMNIC_ALLOCATOR_H
+
+#include <omnic/common.h>
+#include <stddef.h>  // For size_t
+#include <string.h>  // For memcpy
+
+/* -------------------------------------------------------------------------- */
+
+/// @file allocator.h
+/// @brief Pluggable memory allocation for OmniC containers.
+///
+/// An oc_allocator_t bundles allocation callbacks with a context pointer, so
+/// a container can draw its memory from an arena, a pool, a jemalloc arena
+/// or huge pages instead of malloc(). Every callback also receives the
+/// size of the block, which lets simple arenas and size-class pools work
+/// without per-block headers.
+///
+/// A module adopts it by taking a `const oc_allocator_t*` in a
+/// *_with_allocator constructor (NULL meaning oc_allocator_default()),
+/// keeping the pointer next to its data and routing every allocation
+/// through oc_allocator_alloc(), oc_allocator_realloc() and
+/// oc_allocator_free(). The allocator must outlive every object using it.
+///
+/// static void* arena_alloc(void* ctx, size_t size) { ... }
+/// static void arena_free(void* ctx, void* ptr, size_t size) { (void)0; }
+/// oc_allocator_t arena = {arena_alloc, NULL, arena_free, &my_arena};
+/// oc_vector_t* vec = oc_vector_create_with_allocator(sizeof(int), &arena);
+
+/* -------------------------------------------------------------------------- */
+
+/// @brief Allocation callbacks and their context.
+typedef struct oc_allocator {
+  /// Returns a block of at least `size` bytes (size > 0), aligned for any
+  /// object type, or NULL on failure.
+  void* (*alloc)(void* ctx, size_t size);
+  /// Resizes the `old_size`-byte block `ptr` to `new_size` bytes, keeping
+  /// its contents up to the smaller size. Returns the possibly moved block,
+  /// or NULL on failure with `ptr` left valid. May be NULL, in which case
+  /// oc_allocator_realloc() allocates, copies and frees instead.
+  void* (*realloc)(void* ctx, void* ptr, size_t old_size, size_t new_size);
+  /// Releases the `size`-byte block `ptr`; never called with NULL.
+  void (*free)(void* ctx, void* ptr, size_t size);
+  /// Passed unchanged to every callback.
+  void* ctx;
+} oc_allocator_t;
+
+/// @brief Returns the allocator backed by malloc(), realloc() and free().
+const oc_allocator_t* oc_allocator_default(void);
+
+/* -------------------------------------------------------------------------- */
+
+// --- Helpers for Containers ---
+
+/// @brief Allocates `size` bytes from `a`, or from the default allocator
+///        if `a` is NULL.
+/// @return The block, or NULL on failure or if size is 0.
+static inline void* oc_allocator_alloc(const oc_allocator_t* a, size_t size) {
+  if (!a)
+    a = oc_allocator_default();
+  return size > 0 ? a->alloc(a->ctx, size) : NULL;
+}
+
+/// @brief Frees a block obtained from the same allocator; NULL is ignored.
+static inline void oc_allocator_free(const oc_allocator_t* a, void* ptr,
+                                     size_t size) {
+  if (!a)
+    a = oc_allocator_default();
+  if (ptr)
+    a->free(a->ctx, ptr, size);
+}
+
+/// @brief Resizes a block obtained from the same allocator.
+///
+/// A NULL `ptr` allocates. Allocators without a realloc callback get a new
+/// block, a copy and a free.
+/// @return The resized block, or NULL on failure with `ptr` left valid.
+static inline void* oc_allocator_realloc(const oc_allocator_t* a, void* ptr,
+                                         size_t old_size, size_t new_size) {
+  if (!a)
+    a = oc_allocator_default();
+  if (!ptr)
+    return oc_allocator_alloc(a, new_size);
+  if (a->realloc)
+    return a->realloc(a->ctx, ptr, old_size, new_size);
+
+  void* block = oc_allocator_alloc(a, new_size);
+  if (block) {
+    memcpy(block, ptr, old_size < new_size ? old_size : new_size);
+    a->free(a->ctx, ptr, old_size);
+  }
+  return block;
+}
+
+#endif  // OMNIC_ALLOCATOR_H
@@ -17,6 +17,7 @@ typedef enum {
   OC_ERROR_ALLOC = -1,          ///< Failed to allocate memory.
   OC_ERROR_INVALID_ARG = -2,    ///< An invalid argument was provided.
   OC_ERROR_OUT_OF_BOUNDS = -3,  ///< Index or access was out of bounds.
+  OC_ERROR_IO = -4,             ///< A file could not be read or written.
 } oc_error_code_t;
 
 #endif  // OMNIC_COMMON_H
\ No newline at end of file
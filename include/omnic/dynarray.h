@@ -52,6 +52,7 @@
 #define daat      oc_da_at      // TODO
 #define dalast    oc_da_last
 #define dafind    oc_da_find
+#define dasort    oc_da_sort
 #define dadump    oc_da_dump
 #endif
 // clang-format on
@@ -217,6 +218,15 @@ static inline int _oc_da_grow(void** da, size_t new_cap, size_t elem_size) {
     _oc_da_find_index;                                      \
   })
 
+/// @brief Sorts the dynarray in place with the introsort that
+/// OC_SORT_DEFINE() generated for its element type. Not stable.
+///
+/// OC_SORT_DEFINE(ints, int, *a < *b)
+/// oc_da_sort(my_da, ints);
+/// @param da The dynarray. Can be NULL.
+/// @param name The `name` given to OC_SORT_DEFINE() (see typedsort.h).
+#define oc_da_sort(da, name) name##_sort((da), oc_da_len(da))
+
 /// @brief Prints the contents of the dynarray to a stream (C-style
 /// `operator<<`).
 /// @param da The dynarray.
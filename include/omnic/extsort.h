@@ -0,0 +1,84 @@
+// -*- mode: C; indent-tabs-mode: nil; c-basic-offset: 2; tab-width: 2; -*-
+
+#ifndef OMNIC_EXTSORT_H
+#define OMNIC_EXTSORT_H
+
+#include <omnic/common.h>
+#include <omnic/sorting.h>
+#include <stddef.h>  // For size_t
+
+/* -------------------------------------------------------------------------- */
+
+/// @file extsort.h
+/// @brief External merge sort for record files larger than memory.
+///
+/// Sorts a binary file of raw oc_sort_entry_t records by key:
+///
+/// 1. The input is read in chunks that fill the memory budget; each chunk is
+///    sorted in memory and spilled as a sorted run to a temporary file.
+/// 2. Runs are merged, at most `fan_in` at a time, with a loser tree. If
+///    there are more runs than the fan-in, intermediate passes merge groups
+///    of runs into a second temporary file until one final merge writes the
+///    output.
+///
+/// All file access is large sequential reads and writes through buffers
+/// carved out of the same memory budget. Temporary files are unlinked as
+/// soon as they are created, so nothing is left behind on failure. An input
+/// that fits in the budget is sorted in memory without temporary files.
+///
+/// oc_extsort_config_t cfg = oc_extsort_default_config();
+/// cfg.memory_limit = (size_t)1 << 30;
+/// cfg.temp_dir = "/scratch";
+/// oc_error_code_t err = oc_extsort_file("in.bin", "out.bin", &cfg, NULL);
+
+/// Default memory budget in bytes.
+#define OC_EXTSORT_DEFAULT_MEMORY_LIMIT ((size_t)256 << 20)
+/// Default number of runs merged at once.
+#define OC_EXTSORT_DEFAULT_FAN_IN 64
+
+/* -------------------------------------------------------------------------- */
+
+/// @brief External sort settings.
+typedef struct {
+  /// Bytes for the chunk buffer, later split into the merge I/O buffers.
+  /// Scratch memory allocated by `sort` itself is not counted.
+  size_t memory_limit;
+  /// Maximum number of runs merged in one pass (at least 2).
+  size_t fan_in;
+  /// Directory for temporary run files; NULL uses $TMPDIR, then /tmp.
+  const char* temp_dir;
+  /// In-memory sort for each chunk; NULL uses oc_sort_pdq(). Equal keys
+  /// are merged in input order, so a stable sort here (e.g. oc_sort_tim)
+  /// makes the whole external sort stable.
+  void (*sort)(oc_sort_list_t* list);
+} oc_extsort_config_t;
+
+/// @brief Counters describing a finished external sort.
+typedef struct {
+  size_t records;       ///< Records sorted.
+  size_t runs;          ///< Sorted runs spilled (0 if sorted in memory).
+  size_t merge_passes;  ///< Merge passes over the data, including the last.
+} oc_extsort_stats_t;
+
+/// @brief Returns the default settings.
+/// @return A config with the default memory limit and fan-in, the system
+///         temporary directory and oc_sort_pdq() as chunk sort.
+oc_extsort_config_t oc_extsort_default_config(void);
+
+/// @brief Sorts a file of oc_sort_entry_t records by key.
+///
+/// The input is read completely before the output is opened, so `out_path`
+/// may name the input file to sort it in place.
+/// @param in_path Input file; its size must be a multiple of
+///                sizeof(oc_sort_entry_t).
+/// @param out_path Output file, created or truncated.
+/// @param config Settings, or NULL for the defaults.
+/// @param stats Receives counters on success; may be NULL.
+/// @return OC_SUCCESS; OC_ERROR_INVALID_ARG for a bad config or a truncated
+///         record; OC_ERROR_ALLOC if the budget cannot be allocated;
+///         OC_ERROR_IO if a file cannot be opened, read or written.
+oc_error_code_t oc_extsort_file(const char* in_path, const char* out_path,
+                                const oc_extsort_config_t* config,
+                                oc_extsort_stats_t* stats);
+
+#endif  // OMNIC_EXTSORT_H
@@ -0,0 +1,80 @@
+// -*- mode: C; indent-tabs-mode: nil; c-basic-offset: 2; tab-width: 2; -*-
+
+#ifndef OMNIC_PERFCOUNT_H
+#define OMNIC_PERFCOUNT_H
+
+#include <omnic/common.h>
+#include <stdbool.h>  // For bool
+#include <stddef.h>   // For size_t
+#include <stdint.h>   // For uint64_t
+
+/* -------------------------------------------------------------------------- */
+
+/// @file perfcount.h
+/// @brief Hardware performance counters around a code region.
+///
+/// A thin wrapper over Linux perf_event_open() for benchmarks. The counters
+/// cover the calling thread and threads it creates while they are open, in
+/// user space only. Each event is opened on its own, so an event the CPU,
+/// kernel or hypervisor does not provide (or that perf_event_paranoid
+/// forbids) is just marked unavailable while the others keep counting. On
+/// other systems every event is unavailable and the calls do nothing.
+///
+/// oc_perf_counters_t pc;
+/// oc_perf_open(&pc);
+/// oc_perf_start(&pc);
+/// work();
+/// oc_perf_sample_t s;
+/// oc_perf_stop(&pc, &s);
+/// if (s.valid[OC_PERF_INSTRUCTIONS]) ...
+/// oc_perf_close(&pc);
+
+/// @brief Counted events.
+typedef enum {
+  OC_PERF_CYCLES,         ///< CPU cycles.
+  OC_PERF_INSTRUCTIONS,   ///< Instructions retired.
+  OC_PERF_BRANCH_MISSES,  ///< Mispredicted branches.
+  OC_PERF_L1D_MISSES,     ///< L1 data cache read misses.
+  OC_PERF_LLC_MISSES,     ///< Last-level cache read misses.
+  OC_PERF_DTLB_MISSES,    ///< Data TLB read misses.
+  OC_PERF_EVENT_COUNT
+} oc_perf_event_t;
+
+/// @brief Open counters; an fd of -1 marks an unavailable event.
+typedef struct {
+  int fd[OC_PERF_EVENT_COUNT];
+  /// Value, time enabled and time running read by oc_perf_start().
+  uint64_t base[OC_PERF_EVENT_COUNT][3];
+} oc_perf_counters_t;
+
+/// @brief Counts of one measured region.
+typedef struct {
+  /// Counts, scaled up if the kernel had to multiplex the counters.
+  uint64_t value[OC_PERF_EVENT_COUNT];
+  /// Whether the event was counted; value is 0 otherwise.
+  bool valid[OC_PERF_EVENT_COUNT];
+} oc_perf_sample_t;
+
+/// @brief Short name of an event, e.g. "branch-misses".
+const char* oc_perf_event_name(oc_perf_event_t event);
+
+/// @brief Opens every event that is available, disabled.
+/// @param pc Counters to initialize.
+/// @return The number of events that could be opened (0 if none).
+size_t oc_perf_open(oc_perf_counters_t* pc);
+
+/// @brief Returns whether an event was opened by oc_perf_open().
+bool oc_perf_available(const oc_perf_counters_t* pc, oc_perf_event_t event);
+
+/// @brief Enables the open counters and records their current readings.
+void oc_perf_start(oc_perf_counters_t* pc);
+
+/// @brief Disables the open counters and reads them.
+/// @param pc Counters started with oc_perf_start().
+/// @param sample Receives the counts since oc_perf_start().
+void oc_perf_stop(oc_perf_counters_t* pc, oc_perf_sample_t* sample);
+
+/// @brief Closes the counters; they read as unavailable afterwards.
+void oc_perf_close(oc_perf_counters_t* pc);
+
+#endif  // OMNIC_PERFCOUNT_H
@@ -0,0 +1,122 @@
+// -*- mode: C; indent-tabs-mode: nil; c-basic-offset: 2; tab-width: 2; -*-
+
+#ifndef OMNIC_SEGVECTOR_H
+#define OMNIC_SEGVECTOR_H
+
+#include <omnic/allocator.h>
+#include <omnic/common.h>
+
+/* -------------------------------------------------------------------------- */
+
+/// @file segvector.h
+/// @brief A segmented vector whose elements never move.
+///
+/// Storage is a fixed table of blocks that double in size: block k holds
+/// OC_SEGVECTOR_FIRST_BLOCK << k elements and starts at element
+/// OC_SEGVECTOR_FIRST_BLOCK * (2^k - 1). Growing allocates the next block
+/// and copies nothing, so a pointer to an element stays valid until the
+/// vector is destroyed, and appends never stall on a reallocation or
+/// briefly hold two copies of the data. An index maps to its block and
+/// offset in O(1) with a shift and a leading-zero count. At most half of
+/// the capacity is unused, as with a doubling vector.
+///
+/// The functions mirror the oc_vector_* API with an oc_segvector_ prefix.
+/// Elements are contiguous only within a block; oc_segvector_contiguous()
+/// returns whole runs for bulk processing.
+
+/// log2 of the number of elements in the first block.
+#define OC_SEGVECTOR_FIRST_BLOCK_SHIFT 4
+/// Elements in the first block.
+#define OC_SEGVECTOR_FIRST_BLOCK ((size_t)1 << OC_SEGVECTOR_FIRST_BLOCK_SHIFT)
+
+typedef struct oc_segvector oc_segvector_t;
+
+/* -------------------------------------------------------------------------- */
+
+/// @brief Creates a new segmented vector.
+///
+/// No block is allocated until the first element is added.
+///
+/// @param element_size The size in bytes of a single element.
+/// @return The new vector, or NULL if element_size is 0 or on allocation
+///         failure.
+oc_segvector_t* oc_segvector_create(size_t element_size);
+
+/// @brief Creates a segmented vector that allocates through `allocator`.
+///
+/// @param element_size The size in bytes of a single element.
+/// @param allocator The allocator, or NULL for oc_allocator_default(). It
+///                  must outlive the vector.
+/// @return The new vector, or NULL on invalid arguments or allocation
+///         failure.
+oc_segvector_t* oc_segvector_create_with_allocator(
+    size_t element_size, const oc_allocator_t* allocator);
+
+/// @brief Destroys a vector and frees all its blocks.
+///
+/// @param vec The vector to destroy. If NULL, the function does nothing.
+void oc_segvector_destroy(oc_segvector_t* vec);
+
+/// @brief Appends an element to the end of the vector.
+///
+/// Allocates a new block when the last one is full; existing elements are
+/// not touched.
+///
+/// @param vec A pointer to the vector.
+/// @param element A pointer to the element to be copied into the vector.
+/// @return OC_SUCCESS, OC_ERROR_INVALID_ARG, or OC_ERROR_ALLOC.
+oc_error_code_t oc_segvector_push_back(oc_segvector_t* vec,
+                                       const void* element);
+
+/// @brief Appends `count` elements with one copy per block they span.
+///
+/// @param vec A pointer to the vector.
+/// @param elements The elements to copy; may be NULL if count is 0.
+/// @param count The number of elements.
+/// @return OC_SUCCESS, OC_ERROR_INVALID_ARG, or OC_ERROR_ALLOC. On failure
+///         the size is unchanged, though blocks may have been added.
+oc_error_code_t oc_segvector_append_n(oc_segvector_t* vec,
+                                      const void* elements, size_t count);
+
+/// @brief Allocates blocks until the capacity is at least `capacity`.
+///
+/// @param vec A pointer to the vector.
+/// @param capacity The minimum capacity in elements.
+/// @return OC_SUCCESS, OC_ERROR_INVALID_ARG if vec is NULL, or
+///         OC_ERROR_ALLOC.
+oc_error_code_t oc_segvector_reserve(oc_segvector_t* vec, size_t capacity);
+
+/// @brief Retrieves a pointer to the element at a specific index.
+///
+/// @param vec A pointer to the vector.
+/// @param index The index of the element to retrieve.
+/// @return A pointer to the element, valid until the vector is destroyed,
+///         or NULL if the index is out of bounds.
+const void* oc_segvector_get(const oc_segvector_t* vec, size_t index);
+
+/// @brief Returns the run of elements stored contiguously from `index`.
+///
+/// for (size_t i = 0, n; i < oc_segvector_size(vec); i += n) {
+///   const int* run = oc_segvector_contiguous(vec, i, &n);
+///   for (size_t j = 0; j < n; ++j) sum += run[j];
+/// }
+///
+/// @param vec A pointer to the vector.
+/// @param index The first element of the run.
+/// @param count Receives the number of elements in the run, which ends at
+///              the end of index's block or at the size.
+/// @return A pointer to element `index`, or NULL (with *count 0) if the
+///         index is out of bounds.
+void* oc_segvector_contiguous(oc_segvector_t* vec, size_t index,
+                              size_t* count);
+
+/// @brief Gets the number of elements currently in the vector.
+size_t oc_segvector_size(const oc_segvector_t* vec);
+
+/// @brief Gets the number of elements the allocated blocks can hold.
+size_t oc_segvector_capacity(const oc_segvector_t* vec);
+
+/// @brief Gets the size in bytes of one element.
+size_t oc_segvector_element_size(const oc_segvector_t* vec);
+
+#endif  // OMNIC_SEGVECTOR_H
@@ -3,7 +3,9 @@
 #ifndef OMNIC_SORTING_H
 #define OMNIC_SORTING_H
 
-#include <stddef.h>  // For size_t
+#include <omnic/common.h>
+#include <stdbool.h>  // For bool
+#include <stddef.h>   // For size_t
 
 /* -------------------------------------------------------------------------- */
 
@@ -12,10 +14,14 @@
 ///
 /// Implements various sorting algorithms on a sequential list structure.
 /// Based on standard data structure textbook algorithms (Programs 10.1~10.7).
-
-// Maximum size for the static array.
-// User requested up to 100,000 elements for benchmarking.
-#define OC_SORT_MAX_SIZE 100005
+///
+/// The list is a non-owning view over a caller-provided buffer, so any
+/// amount of data can be sorted in place without copying:
+///
+/// oc_sort_entry_t* buf = malloc(n * sizeof(oc_sort_entry_t));
+/// /* ... fill buf[0] ... buf[n - 1] ... */
+/// oc_sort_list_t list = oc_sort_list_view(buf, n);
+/// oc_sort_quick(&list);
 
 typedef int oc_key_type_t;   ///< The type of the sorting key (comparable).
 typedef int oc_data_type_t;  ///< The type of the data payload.
@@ -28,13 +34,23 @@ typedef struct {
 
 /// @brief Sequential list structure for sorting.
 ///
-/// Note: Typically, these algorithms might use index 0 as a sentinel.
-/// We will assume the data is stored in d[1]...d[n].
+/// A view (pointer + length) over caller-owned storage. Elements are stored
+/// in d[0]...d[n - 1]; there is no sentinel slot. The list never allocates
+/// or frees `d`.
 typedef struct {
-  int n;                                ///< Number of elements to sort.
-  oc_sort_entry_t d[OC_SORT_MAX_SIZE];  ///< Static array of elements.
+  oc_sort_entry_t* d;  ///< First element of the caller-owned buffer.
+  size_t n;            ///< Number of elements to sort.
 } oc_sort_list_t;
 
+/// @brief Builds a sort view over an existing buffer.
+/// @param d Pointer to the first element. May be NULL only if n is 0.
+/// @param n Number of elements in the buffer.
+/// @return A list referring to (not copying) the buffer.
+static inline oc_sort_list_t oc_sort_list_view(oc_sort_entry_t* d, size_t n) {
+  oc_sort_list_t list = {d, n};
+  return list;
+}
+
 /* -------------------------------------------------------------------------- */
 
 // --- Sorting Algorithms ---
@@ -51,16 +67,352 @@ void oc_sort_insertion(oc_sort_list_t* list);
 /// @param list Pointer to the list to sort.
 void oc_sort_bubble(oc_sort_list_t* list);
 
-/// @brief Quick Sort.
+/// @brief Quick Sort (introsort).
+///
+/// Median-of-three / ninther pivots, recursion into the smaller partition
+/// only, a heap sort fallback past 2*log2(n) levels and a sorting network
+/// (sortnet.h) on small ranges. Worst case O(n log n) time, O(log n) stack.
+/// Not stable.
 /// @param list Pointer to the list to sort.
 void oc_sort_quick(oc_sort_list_t* list);
 
+/// @brief Pattern-defeating Quick Sort (pdqsort).
+///
+/// Quick sort with branchless block partitioning, pattern breaking on
+/// unbalanced partitions, special handling of runs of equal keys and a heap
+/// sort fallback. Ranges that are found already partitioned are finished
+/// with a bounded insertion sort, so sorted input takes linear time. Worst
+/// case O(n log n). Not stable.
+/// @param list Pointer to the list to sort.
+void oc_sort_pdq(oc_sort_list_t* list);
+
 /// @brief Two-way Merge Sort.
+///
+/// Stable. Needs an n-element scratch buffer; if it cannot be allocated the
+/// list is sorted with oc_sort_merge_in_place() and no buffer instead.
 /// @param list Pointer to the list to sort.
 void oc_sort_merge(oc_sort_list_t* list);
 
+/// @brief Iterative (bottom-up) Two-way Merge Sort.
+///
+/// Sorts short runs with a sorting network, then merges them in passes of
+/// doubling width that alternate between the list and a scratch buffer,
+/// with at most one final copy. Stable. Needs an n-element scratch buffer;
+/// if it cannot be allocated the list is sorted with
+/// oc_sort_merge_in_place() and no buffer instead.
+/// @param list Pointer to the list to sort.
+void oc_sort_merge_bottom_up(oc_sort_list_t* list);
+
+/// @brief Multithreaded Two-way Merge Sort.
+///
+/// Splits the list into one chunk per thread, sorts the chunks concurrently
+/// and merges them in parallel rounds, splitting every merge across threads
+/// with co-rank (merge path) partitioning. Stable. Small lists, or a thread
+/// count of 1, fall back to oc_sort_merge(). Needs an n-element scratch
+/// buffer; if it cannot be allocated the list is sorted on the calling
+/// thread with oc_sort_merge_in_place() and no buffer instead.
+/// @param list Pointer to the list to sort.
+/// @param num_threads Number of threads to use; 0 selects the number of
+///                    online CPUs.
+void oc_sort_merge_parallel(oc_sort_list_t* list, unsigned num_threads);
+
+/// @brief In-place stable merge sort for low-memory environments.
+///
+/// Merges adjacent runs through a buffer of at most `buffer_entries`
+/// entries when the shorter run fits, and otherwise by splitting both runs
+/// with binary search and swapping the middle pieces with a rotation. A
+/// buffer of about sqrt(n) entries keeps the cost close to O(n log n); with
+/// none the rotations make it O(n log^2 n). Stable. Apart from the buffer
+/// it uses 2 KiB and O(log n) of stack.
+/// @param list Pointer to the list to sort.
+/// @param buffer_entries Size of the heap buffer to allocate, in entries;
+///                       256 or fewer allocates nothing and uses a
+///                       256-entry stack buffer.
+/// @return OC_SUCCESS; OC_ERROR_ALLOC if the requested buffer cannot be
+///         allocated, in which case the list is left unchanged and a call
+///         with buffer_entries = 0 still sorts it.
+oc_error_code_t oc_sort_merge_in_place(oc_sort_list_t* list,
+                                       size_t buffer_entries);
+
+/// @brief Multithreaded Sample Sort.
+///
+/// Picks up to 255 splitters from an oversampled random sample, classifies
+/// the keys into buckets in parallel with a branch-free splitter tree,
+/// scatters them into a scratch buffer in one pass and sorts the buckets
+/// concurrently. Keys equal to a splitter get buckets of their own, so
+/// heavy duplicates do not serialize the sort. Not stable. Small lists, or a
+/// thread count of 1, fall back to oc_sort_pdq(). Needs an n-element scratch
+/// buffer plus 2 bytes per element; if these cannot be allocated the list is
+/// sorted with oc_sort_pdq() instead.
+/// @param list Pointer to the list to sort.
+/// @param num_threads Number of threads to use; 0 selects the number of
+///                    online CPUs.
+void oc_sort_sample_parallel(oc_sort_list_t* list, unsigned num_threads);
+
+/// @brief Adaptive natural merge sort (Timsort with the powersort policy).
+///
+/// Detects ascending and strictly descending runs, extends short runs with
+/// binary insertion and merges them with galloping. Stable; about O(n) on
+/// already ordered or nearly ordered data, O(n log n) worst case. Needs up
+/// to n/2 elements of scratch; if it cannot be allocated the list is sorted
+/// with oc_sort_merge_in_place() and no buffer instead.
+/// @param list Pointer to the list to sort.
+void oc_sort_tim(oc_sort_list_t* list);
+
 /// @brief Heap Sort.
 /// @param list Pointer to the list to sort.
 void oc_sort_heap(oc_sort_list_t* list);
 
+/// @brief Cache-friendly 4-ary Heap Sort.
+///
+/// The four children of a node are adjacent, and the heap is shifted up to
+/// three entries into the array so that each sibling group fills one
+/// aligned half cache line. Every level of a sift then touches one new
+/// line, over half the depth of a binary heap. The skipped entries are
+/// inserted into the sorted rest at the end. The grandchildren are
+/// prefetched while the children are compared, and the sortdown uses
+/// Floyd's bottom-up sift, which skips the comparison against the sifted
+/// entry on the way down. In place, not stable, O(n log n) worst case.
+/// @param list Pointer to the list to sort.
+void oc_sort_heap_dary(oc_sort_list_t* list);
+
+/// @brief LSD Radix Sort on the integer key.
+///
+/// Stable, O(n) with one pass per key byte; passes over bytes that every key
+/// shares are skipped. Needs an n-element scratch buffer; if it cannot be
+/// allocated the list is sorted with oc_sort_merge_in_place() and no buffer
+/// instead.
+/// @param list Pointer to the list to sort.
+void oc_sort_radix(oc_sort_list_t* list);
+
+/// @brief Counting Sort for keys from a small range.
+///
+/// Stable, O(n + max - min): one pass finds the key range, one counts every
+/// key and one scatters the entries to their final place. Lists whose range
+/// exceeds 65536 keys are radix sorted instead. Needs an n-element scratch
+/// buffer and a counter per key in the range; if they cannot be allocated
+/// the list is sorted with oc_sort_merge_in_place() and no buffer instead.
+/// @param list Pointer to the list to sort.
+void oc_sort_counting(oc_sort_list_t* list);
+
+// --- Automatic Algorithm Selection ---
+
+/// @brief Algorithms oc_sort_auto() can choose.
+typedef enum {
+  OC_SORT_PATH_NONE,       ///< Already sorted (or fewer than 2 entries).
+  OC_SORT_PATH_REVERSE,    ///< Non-increasing keys: reversed in place.
+  OC_SORT_PATH_INSERTION,  ///< Insertion sort for tiny lists.
+  OC_SORT_PATH_COUNTING,   ///< Counting sort for a key range up to n.
+  OC_SORT_PATH_PDQ,        ///< Pdqsort for small or nearly sorted lists.
+  OC_SORT_PATH_RADIX,      ///< LSD radix sort.
+  OC_SORT_PATH_PARALLEL,   ///< Parallel sample sort on every online CPU.
+} oc_sort_path_t;
+
+/// @brief What oc_sort_auto() measured and decided.
+typedef struct {
+  oc_sort_path_t path;    ///< Algorithm chosen (or used, after a fallback).
+  size_t n;               ///< Number of entries.
+  oc_key_type_t min_key;  ///< Smallest key (0 if n is 0).
+  oc_key_type_t max_key;  ///< Largest key (0 if n is 0).
+  size_t descents;        ///< Neighbours with d[i].key < d[i - 1].key.
+  size_t ascents;         ///< Neighbours with d[i].key > d[i - 1].key.
+} oc_sort_plan_t;
+
+/// @brief Returns a short name for a path, e.g. "radix".
+const char* oc_sort_path_name(oc_sort_path_t path);
+
+/// @brief Measures a list and picks the algorithm oc_sort_auto() would use.
+///
+/// One sequential pass over the keys finds their range and counts the
+/// ascending and descending neighbours. Sorted and non-increasing lists
+/// need no sort; tiny lists get insertion sort; small key ranges counting
+/// sort; nearly sorted lists (at most n / 16 descents) pdqsort; large lists
+/// the parallel sample sort if at least 4 CPUs are online; the rest radix
+/// sort, or pdqsort below 256 entries.
+/// @param list Pointer to the list to inspect; it is not modified.
+/// @return The measurements and the chosen path.
+oc_sort_plan_t oc_sort_auto_plan(const oc_sort_list_t* list);
+
+/// @brief Sorts with the algorithm oc_sort_auto_plan() picks.
+///
+/// Not stable. If the counting or radix sort cannot allocate its scratch
+/// buffer the list is pdqsorted instead and the returned path says so.
+/// @param list Pointer to the list to sort.
+/// @return The plan that was carried out.
+oc_sort_plan_t oc_sort_auto(oc_sort_list_t* list);
+
+// --- K-way Merge ---
+
+/// Entries buffered per source (and for the output) when
+/// oc_sort_merge_k_stream() allocates its own buffer.
+#define OC_SORT_STREAM_BUFFER 4096
+
+/// @brief K-way Merge of sorted runs (loser tree).
+///
+/// Merges k runs, each already sorted by key, into `out` with about
+/// log2(k) comparisons per entry, reading every run front to back. Stable:
+/// equal keys come out in run order. The output must not overlap the runs.
+/// @param runs Array of k sorted runs.
+/// @param k Number of runs.
+/// @param out Destination; out->n must be at least the total length, and is
+///            set to it on success.
+/// @return OC_SUCCESS, OC_ERROR_INVALID_ARG if `out` is too short, or
+///         OC_ERROR_ALLOC if the tree cannot be allocated.
+oc_error_code_t oc_sort_merge_k(const oc_sort_list_t* runs, size_t k,
+                                oc_sort_list_t* out);
+
+/// @brief A sorted input read in blocks, e.g. from a file or socket.
+typedef struct {
+  /// Stores up to `cap` next entries in `buf` and their count in `*got`;
+  /// a count of 0 marks the end. Any error code other than OC_SUCCESS
+  /// aborts the merge and is returned by it.
+  oc_error_code_t (*read)(void* ctx, oc_sort_entry_t* buf, size_t cap,
+                          size_t* got);
+  void* ctx;  ///< Passed to `read`.
+} oc_sort_source_t;
+
+/// @brief Consumer of merged output blocks.
+typedef struct {
+  /// Takes the next `n` entries of the output. Any error code other than
+  /// OC_SUCCESS aborts the merge and is returned by it.
+  oc_error_code_t (*write)(void* ctx, const oc_sort_entry_t* d, size_t n);
+  void* ctx;  ///< Passed to `write`.
+} oc_sort_sink_t;
+
+/// @brief K-way Merge of sorted streams (loser tree).
+///
+/// Like oc_sort_merge_k(), but the runs are pulled from sources and the
+/// output pushed to a sink in blocks, so nothing needs to fit in memory.
+/// The buffer is split into k + 1 equal slices: one per source and one for
+/// the output.
+/// @param sources Array of k sorted sources.
+/// @param k Number of sources.
+/// @param sink Receives the merged entries in order.
+/// @param buf Buffer of `buf_entries` entries, or NULL to allocate
+///            (k + 1) * OC_SORT_STREAM_BUFFER entries.
+/// @param buf_entries Size of `buf`; at least k + 1. Ignored if buf is NULL.
+/// @return OC_SUCCESS, OC_ERROR_INVALID_ARG if the buffer is too small,
+///         OC_ERROR_ALLOC, or the first error reported by a source or the
+///         sink.
+oc_error_code_t oc_sort_merge_k_stream(oc_sort_source_t* sources, size_t k,
+                                       oc_sort_sink_t* sink,
+                                       oc_sort_entry_t* buf,
+                                       size_t buf_entries);
+
+// --- Selection and Top-k ---
+
+/// @brief Selection (nth element), introselect with Floyd-Rivest sampling.
+///
+/// Rearranges the list so that d[nth] holds the entry that would be there if
+/// the list were sorted, with no larger key before it and no smaller key
+/// after it. Expected O(n) time, O(n log n) worst case. Not stable.
+/// @param list Pointer to the list to rearrange.
+/// @param nth Zero-based rank to select.
+/// @return OC_SUCCESS, or OC_ERROR_OUT_OF_BOUNDS if nth >= list->n.
+oc_error_code_t oc_select_nth(oc_sort_list_t* list, size_t nth);
+
+/// @brief Partial Sort.
+///
+/// Puts the k smallest entries, sorted, in d[0]...d[k - 1]; the rest of the
+/// list is left in unspecified order. O(n + k log k) time. A k of n or more
+/// sorts the whole list. Not stable.
+/// @param list Pointer to the list to sort.
+/// @param k Number of leading entries to sort.
+void oc_sort_partial(oc_sort_list_t* list, size_t k);
+
+/// @brief Streaming top-k: a bounded heap over a caller-owned buffer.
+///
+/// Keeps the k entries with the largest (or smallest) keys seen so far in
+/// O(log k) per pushed entry, so the top k of a stream of n entries cost
+/// O(n log k) time and no memory beyond the k-entry buffer:
+///
+/// oc_sort_entry_t best[100];
+/// oc_topk_t topk = oc_topk_init(best, 100, true);
+/// /* ... oc_topk_push(&topk, e) for every entry ... */
+/// oc_sort_list_t top = oc_topk_finish(&topk);  // best[0] is the largest
+typedef struct {
+  oc_sort_entry_t* d;  ///< Caller-owned buffer of `capacity` entries.
+  size_t capacity;     ///< k, the number of entries to keep.
+  size_t n;            ///< Entries currently kept (at most `capacity`).
+  bool largest;        ///< Keep the largest keys; otherwise the smallest.
+} oc_topk_t;
+
+/// @brief Starts an empty top-k over an existing buffer.
+/// @param d Buffer for k entries. May be NULL only if k is 0.
+/// @param k Number of entries to keep.
+/// @param largest True to keep the largest keys, false for the smallest.
+/// @return A top-k heap using (not copying) the buffer.
+static inline oc_topk_t oc_topk_init(oc_sort_entry_t* d, size_t k,
+                                     bool largest) {
+  oc_topk_t topk = {d, k, 0, largest};
+  return topk;
+}
+
+/// @brief Offers an entry to the top-k. Among equal keys the entries seen
+/// first are kept.
+/// @param topk Pointer to the top-k heap.
+/// @param e The entry; copied into the buffer if it is kept.
+void oc_topk_push(oc_topk_t* topk, oc_sort_entry_t e);
+
+/// @brief Orders the kept entries best first and empties the heap.
+///
+/// The entries come out in descending key order when keeping the largest,
+/// ascending when keeping the smallest. They stay valid in the buffer until
+/// the next push.
+/// @param topk Pointer to the top-k heap.
+/// @return A view of the kept entries (fewer than k if fewer were pushed).
+oc_sort_list_t oc_topk_finish(oc_topk_t* topk);
+
+// --- Index and Key/Value Sorting ---
+// For payloads wider than oc_data_type_t, or keys kept apart from their
+// payloads: only keys and positions move during the sort, and the payload
+// is moved once afterwards.
+
+/// @brief Index sort (argsort): the permutation that sorts `keys`.
+///
+/// Stable, O(n): (key, position) pairs are radix sorted, so equal keys keep
+/// their input order. `keys` is not modified.
+/// @param keys Keys to order.
+/// @param n Number of keys, at most INT_MAX.
+/// @param perm Receives n positions such that keys[perm[0]],
+///             keys[perm[1]], ... is sorted.
+/// @return OC_SUCCESS; OC_ERROR_INVALID_ARG for NULL arrays or n > INT_MAX;
+///         OC_ERROR_ALLOC if the scratch buffers cannot be allocated.
+oc_error_code_t oc_sort_index(const oc_key_type_t* keys, size_t n,
+                              size_t* perm);
+
+/// @brief Rearranges an array by a permutation, in place.
+///
+/// Afterwards values[i] holds what was values[perm[i]], so applying the
+/// result of oc_sort_index() puts an array in key order. The elements are
+/// gathered into an n-element scratch array and copied back; if that cannot
+/// be allocated they are moved along the cycles of the permutation instead,
+/// which is slower but needs only one element and n bits of scratch space.
+/// @param values Array of n elements of `value_size` bytes each.
+/// @param n Number of elements.
+/// @param value_size Size of one element in bytes (non-zero).
+/// @param perm A permutation of 0..n-1; it is not checked.
+/// @return OC_SUCCESS; OC_ERROR_INVALID_ARG for NULL arrays or a zero size;
+///         OC_ERROR_ALLOC if the scratch space cannot be allocated (values
+///         is then unchanged).
+oc_error_code_t oc_sort_apply_permutation(void* values, size_t n,
+                                          size_t value_size,
+                                          const size_t* perm);
+
+/// @brief Key/value sort over parallel arrays (structure of arrays).
+///
+/// Sorts `keys` and moves values[i] along with keys[i]. Stable. Equivalent
+/// to oc_sort_index() followed by oc_sort_apply_permutation() on both
+/// arrays, without materializing the size_t permutation.
+/// @param keys Keys, sorted in place.
+/// @param values n payloads of `value_size` bytes each; may be NULL if
+///               value_size is 0.
+/// @param n Number of elements, at most INT_MAX.
+/// @param value_size Size of one payload in bytes; 0 sorts only the keys.
+/// @return OC_SUCCESS; OC_ERROR_INVALID_ARG for NULL arrays or n > INT_MAX;
+///         OC_ERROR_ALLOC if the scratch buffers cannot be allocated (both
+///         arrays are then unchanged).
+oc_error_code_t oc_sort_kv(oc_key_type_t* keys, void* values, size_t n,
+                           size_t value_size);
+
 #endif  // OMNIC_SORTING_H
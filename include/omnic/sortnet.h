@@ -0,0 +1,76 @@
+// -*- mode: C; indent-tabs-mode: nil; c-basic-offset: 2; tab-width: 2; -*-
+
+#ifndef OMNIC_SORTNET_H
+#define OMNIC_SORTNET_H
+
+#include <omnic/common.h>
+#include <omnic/sorting.h>
+#include <stdbool.h>  // For bool
+#include <stddef.h>   // For size_t
+
+/* -------------------------------------------------------------------------- */
+
+/// @file sortnet.h
+/// @brief Bitonic sorting-network kernels for small blocks.
+///
+/// Sorts up to OC_SORTNET_MAX keys with a fixed, data-independent network,
+/// so there are no mispredicted branches. On x86 CPUs with AVX2 the network
+/// runs on 256-bit registers (8 ints or 4 entries per register); otherwise
+/// an equivalent scalar network is used. The choice is made at run time, so
+/// the library does not need to be built with -mavx2.
+///
+/// The sort list algorithms in sorting.h use the entry kernels as their
+/// small-range base case; they can also be called directly, e.g. to sort
+/// small per-request arrays.
+
+/// Largest block a network kernel accepts.
+#define OC_SORTNET_MAX 64
+
+/* -------------------------------------------------------------------------- */
+
+/// @brief Sorts up to OC_SORTNET_MAX ints in ascending order.
+/// @param d The ints to sort.
+/// @param n Number of ints.
+/// @return OC_SUCCESS, or OC_ERROR_INVALID_ARG if n > OC_SORTNET_MAX.
+oc_error_code_t oc_sortnet_int(int* d, size_t n);
+
+/// @brief Merges two sorted int arrays into `out`.
+///
+/// Works 8 keys at a time by merging two sorted registers with a bitonic
+/// merge network; the tails are merged in scalar code.
+/// @param a First sorted array.
+/// @param na Length of `a`.
+/// @param b Second sorted array.
+/// @param nb Length of `b`.
+/// @param out Destination of na + nb ints; must not overlap `a` or `b`.
+void oc_sortnet_merge_int(const int* a, size_t na, const int* b, size_t nb,
+                          int* out);
+
+/// @brief Sorts up to OC_SORTNET_MAX entries by key. Not stable: equal keys
+/// end up ordered by their data.
+/// @param d The entries to sort.
+/// @param n Number of entries.
+/// @return OC_SUCCESS, or OC_ERROR_INVALID_ARG if n > OC_SORTNET_MAX.
+oc_error_code_t oc_sortnet_entries(oc_sort_entry_t* d, size_t n);
+
+/// @brief Sorts up to OC_SORTNET_MAX entries by key, keeping equal keys in
+/// their input order.
+/// @param d The entries to sort.
+/// @param n Number of entries.
+/// @return OC_SUCCESS, or OC_ERROR_INVALID_ARG if n > OC_SORTNET_MAX.
+oc_error_code_t oc_sortnet_entries_stable(oc_sort_entry_t* d, size_t n);
+
+/// @brief Reports whether the AVX2 kernels are in use.
+/// @return True if the CPU supports AVX2 and SIMD has not been disabled.
+bool oc_sortnet_simd_enabled(void);
+
+/// @brief Enables or disables the AVX2 kernels (for testing and benchmarks).
+///
+/// Enabling has no effect on CPUs without AVX2. Safe to call while other
+/// threads sort: each kernel call reads the setting once and finishes with
+/// the kernel it selected. A longer sort already running may pick up the
+/// new setting at its next base case; both kernels give the same order.
+/// @param enabled False to force the scalar network.
+void oc_sortnet_set_simd(bool enabled);
+
+#endif  // OMNIC_SORTNET_H
@@ -0,0 +1,265 @@
+// -*- mode: C; indent-tabs-mode: nil; c-basic-offset: 2; tab-width: 2; -*-
+
+#ifndef OMNIC_TYPEDSORT_H_
+#define OMNIC_TYPEDSORT_H_
+
+#include <omnic/common.h>
+#include <stdbool.h>  // For boolean values
+#include <stddef.h>   // For size_t
+#include <stdlib.h>   // For malloc, free
+#include <string.h>   // For memcpy
+
+/* -------------------------------------------------------------------------- */
+
+/// @file typedsort.h
+/// @brief Type-specialized sorting algorithms generated by macro.
+///
+/// OC_SORT_DEFINE() instantiates a family of sort functions for one element
+/// type and ordering. The ordering is an expression over `a` and `b`, both
+/// `const type*`, that is true when `*a` must sort before `*b`. It is pasted
+/// into an inline function, so comparisons compile to direct instructions
+/// instead of calls through a function pointer as with qsort().
+///
+/// USAGE:
+/// typedef struct { uint64_t hi, lo; } u128_t;
+/// OC_SORT_DEFINE(i64, int64_t, *a < *b)
+/// OC_SORT_DEFINE(u128, u128_t,
+///                a->hi < b->hi || (a->hi == b->hi && a->lo < b->lo))
+/// OC_SORT_DEFINE(str, const char*, strcmp(*a, *b) < 0)
+///
+/// i64_sort(values, n);             // Introsort, not stable
+/// u128_sort_merge(keys, n);        // Merge sort, stable
+/// str_sort_heap(names, n);         // Heap sort, no extra memory
+///
+/// Each instantiation `name` defines (all `static inline`):
+/// - name_sort(d, n)               Introsort. O(n log n) worst case.
+/// - name_sort_merge(d, n)         Stable bottom-up merge sort; returns
+///                                 OC_ERROR_ALLOC if scratch is unavailable.
+/// - name_sort_merge_buf(d, n, t)  Same, with caller-provided n-element
+///                                 scratch `t`.
+/// - name_sort_heap(d, n)          Heap sort. In place.
+/// - name_sort_insertion(d, n)     Insertion sort. Stable; for small n.
+/// - name_is_sorted(d, n)          Checks the order.
+/// - name_less(a, b)               The ordering itself.
+
+/* -------------------------------------------------------------------------- */
+
+// --- Internal Implementation Details ---
+
+// Ranges at or below this size are finished with insertion sort.
+#define OC_TYPEDSORT_INSERTION_CUTOFF 16
+// Ranges at or above this size pick the introsort pivot with a ninther.
+#define OC_TYPEDSORT_NINTHER_THRESHOLD 128
+// Run length insertion-sorted before the bottom-up merge passes.
+#define OC_TYPEDSORT_MERGE_RUN 32
+
+// 2 * floor(log2(n)), the introsort recursion budget.
+static inline unsigned _oc_typedsort_depth_limit(size_t n) {
+  unsigned depth = 0;
+  while (n > 1) {
+    n >>= 1;
+    ++depth;
+  }
+  return 2 * depth;
+}
+
+/* -------------------------------------------------------------------------- */
+
+// --- Public API Macros ---
+
+/// @brief Instantiates the sort family for one element type.
+/// @param name Prefix of the generated functions (e.g. `i64` -> `i64_sort`).
+/// @param type Element type; anything assignable, including structs.
+/// @param less_expr Strict weak ordering over `const type* a, b`.
+#define OC_SORT_DEFINE(name, type, less_expr)                                  \
+  /* Comparison: `a` and `b` are `const type*`. */                             \
+  static inline bool name##_less(const type* a, const type* b) {               \
+    return (less_expr);                                                        \
+  }                                                                            \
+                                                                               \
+  static inline void name##_swap(type* x, type* y) {                           \
+    type tmp = *x;                                                             \
+    *x = *y;                                                                   \
+    *y = tmp;                                                                  \
+  }                                                                            \
+                                                                               \
+  /* Sorts d[0, n) by straight insertion. Stable. */                           \
+  static inline void name##_sort_insertion(type* d, size_t n) {                \
+    for (size_t i = 1; i < n; ++i) {                                           \
+      if (name##_less(&d[i], &d[i - 1])) {                                     \
+        type tmp = d[i];                                                       \
+        size_t j = i;                                                          \
+        do {                                                                   \
+          d[j] = d[j - 1];                                                     \
+          --j;                                                                 \
+        } while (j > 0 && name##_less(&tmp, &d[j - 1]));                       \
+        d[j] = tmp;                                                            \
+      }                                                                        \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  /* Sifts d[s] down within the max-heap d[0, n). */                           \
+  static inline void name##_heap_adjust(type* d, size_t s, size_t n) {         \
+    type rc = d[s];                                                            \
+    for (size_t j = 2 * s + 1; j < n; j = 2 * j + 1) {                         \
+      if (j + 1 < n && name##_less(&d[j], &d[j + 1]))                          \
+        ++j;                                                                   \
+      if (!name##_less(&rc, &d[j]))                                            \
+        break;                                                                 \
+      d[s] = d[j];                                                             \
+      s = j;                                                                   \
+    }                                                                          \
+    d[s] = rc;                                                                 \
+  }                                                                            \
+                                                                               \
+  /* Heap sort of d[0, n). Not stable. */                                      \
+  static inline void name##_sort_heap(type* d, size_t n) {                     \
+    if (n < 2)                                                                 \
+      return;                                                                  \
+    for (size_t i = n / 2; i-- > 0;)                                           \
+      name##_heap_adjust(d, i, n);                                             \
+    for (size_t i = n - 1; i > 0; --i) {                                       \
+      name##_swap(&d[0], &d[i]);                                               \
+      name##_heap_adjust(d, 0, i);                                             \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  static inline size_t name##_median3(const type* d, size_t x, size_t y,       \
+                                      size_t z) {                              \
+    if (name##_less(&d[x], &d[y])) {                                           \
+      if (name##_less(&d[y], &d[z]))                                           \
+        return y;                                                              \
+      return name##_less(&d[x], &d[z]) ? z : x;                                \
+    }                                                                          \
+    if (name##_less(&d[x], &d[z]))                                             \
+      return x;                                                                \
+    return name##_less(&d[y], &d[z]) ? z : y;                                  \
+  }                                                                            \
+                                                                               \
+  /* Hoare partition of d[0, n) around a median-of-3 (ninther when large)      \
+   * pivot; returns the pivot's final index. */                                \
+  static inline size_t name##_partition(type* d, size_t n) {                   \
+    size_t mid = n / 2, last = n - 1, m;                                       \
+    if (n >= OC_TYPEDSORT_NINTHER_THRESHOLD) {                                 \
+      size_t s = n / 8;                                                        \
+      m = name##_median3(d, name##_median3(d, 0, s, 2 * s),                    \
+                         name##_median3(d, mid - s, mid, mid + s),             \
+                         name##_median3(d, last - 2 * s, last - s, last));     \
+    } else {                                                                   \
+      m = name##_median3(d, 0, mid, last);                                     \
+    }                                                                          \
+    name##_swap(&d[0], &d[m]);                                                 \
+                                                                               \
+    size_t i = 0, j = n;                                                       \
+    for (;;) {                                                                 \
+      while (name##_less(&d[++i], &d[0])) {                                    \
+        if (i == last)                                                         \
+          break;                                                               \
+      }                                                                        \
+      while (name##_less(&d[0], &d[--j])) {                                    \
+      }                                                                        \
+      if (i >= j)                                                              \
+        break;                                                                 \
+      name##_swap(&d[i], &d[j]);                                               \
+    }                                                                          \
+    name##_swap(&d[0], &d[j]);                                                 \
+    return j;                                                                  \
+  }                                                                            \
+                                                                               \
+  static inline void name##_intro_loop(type* d, size_t n, unsigned depth) {    \
+    while (n > OC_TYPEDSORT_INSERTION_CUTOFF) {                                \
+      if (depth == 0) {                                                        \
+        name##_sort_heap(d, n);                                                \
+        return;                                                                \
+      }                                                                        \
+      --depth;                                                                 \
+      size_t p = name##_partition(d, n);                                       \
+      /* Recurse into the smaller side, loop on the larger one. */             \
+      if (p < n - p - 1) {                                                     \
+        name##_intro_loop(d, p, depth);                                        \
+        d += p + 1;                                                            \
+        n -= p + 1;                                                            \
+      } else {                                                                 \
+        name##_intro_loop(d + p + 1, n - p - 1, depth);                        \
+        n = p;                                                                 \
+      }                                                                        \
+    }                                                                          \
+    name##_sort_insertion(d, n);                                               \
+  }                                                                            \
+                                                                               \
+  /* Introsort of d[0, n): O(n log n) worst case, O(log n) stack. Not          \
+   * stable. */                                                                \
+  static inline void name##_sort(type* d, size_t n) {                          \
+    if (n > 1)                                                                 \
+      name##_intro_loop(d, n, _oc_typedsort_depth_limit(n));                   \
+  }                                                                            \
+                                                                               \
+  /* Stable merge of x[0, nx) and y[0, ny) into out. */                        \
+  static inline void name##_merge_ranges(const type* x, size_t nx,             \
+                                         const type* y, size_t ny,             \
+                                         type* out) {                          \
+    size_t i = 0, j = 0, k = 0;                                                \
+    while (i < nx && j < ny) {                                                 \
+      int take_y = name##_less(&y[j], &x[i]);                                  \
+      const type* next = take_y ? &y[j] : &x[i];                               \
+      out[k++] = *next;                                                        \
+      j += (size_t)take_y;                                                     \
+      i += (size_t)!take_y;                                                    \
+    }                                                                          \
+    while (i < nx)                                                             \
+      out[k++] = x[i++];                                                       \
+    while (j < ny)                                                             \
+      out[k++] = y[j++];                                                       \
+  }                                                                            \
+                                                                               \
+  /* Bottom-up merge sort of d[0, n) using the caller's n-element scratch      \
+   * buffer `tmp`. Stable; never allocates. */                                 \
+  static inline void name##_sort_merge_buf(type* d, size_t n, type* tmp) {     \
+    for (size_t lo = 0; lo < n; lo += OC_TYPEDSORT_MERGE_RUN) {                \
+      size_t len = n - lo < OC_TYPEDSORT_MERGE_RUN ? n - lo                    \
+                                                   : OC_TYPEDSORT_MERGE_RUN;   \
+      name##_sort_insertion(d + lo, len);                                      \
+    }                                                                          \
+    type* src = d;                                                             \
+    type* dst = tmp;                                                           \
+    for (size_t w = OC_TYPEDSORT_MERGE_RUN; w < n; w *= 2) {                   \
+      for (size_t lo = 0; lo < n; lo += 2 * w) {                               \
+        size_t mid = n - lo < w ? n : lo + w;                                  \
+        size_t hi = n - mid < w ? n : mid + w;                                 \
+        if (mid == hi || !name##_less(&src[mid], &src[mid - 1]))               \
+          memcpy(dst + lo, src + lo, (hi - lo) * sizeof(type));                \
+        else                                                                   \
+          name##_merge_ranges(src + lo, mid - lo, src + mid, hi - mid,         \
+                              dst + lo);                                       \
+      }                                                                        \
+      type* t = src;                                                           \
+      src = dst;                                                               \
+      dst = t;                                                                 \
+    }                                                                          \
+    if (src != d)                                                              \
+      memcpy(d, src, n * sizeof(type));                                        \
+  }                                                                            \
+                                                                               \
+  /* Bottom-up merge sort of d[0, n). Stable. Returns OC_ERROR_ALLOC, leaving  \
+   * d untouched, if the scratch buffer cannot be allocated. */                \
+  static inline oc_error_code_t name##_sort_merge(type* d, size_t n) {         \
+    if (n < 2)                                                                 \
+      return OC_SUCCESS;                                                       \
+    type* tmp = (type*)malloc(n * sizeof(type));                               \
+    if (!tmp)                                                                  \
+      return OC_ERROR_ALLOC;                                                   \
+    name##_sort_merge_buf(d, n, tmp);                                          \
+    free(tmp);                                                                 \
+    return OC_SUCCESS;                                                         \
+  }                                                                            \
+                                                                               \
+  /* Returns true if d[0, n) is in non-descending order. */                    \
+  static inline bool name##_is_sorted(const type* d, size_t n) {               \
+    for (size_t i = 1; i < n; ++i) {                                           \
+      if (name##_less(&d[i], &d[i - 1]))                                       \
+        return false;                                                          \
+    }                                                                          \
+    return true;                                                               \
+  }
+
+#endif  // OMNIC_TYPEDSORT_H_
@@ -0,0 +1,174 @@
+// -*- mode: C; indent-tabs-mode: nil; c-basic-offset: 2; tab-width: 2; -*-
+
+#ifndef OMNIC_TYPEDVECTOR_H_
+#define OMNIC_TYPEDVECTOR_H_
+
+#include <assert.h>  // For bounds checks in debug builds
+#include <omnic/common.h>
+#include <omnic/vector.h>
+#include <stdint.h>  // For SIZE_MAX
+#include <stdlib.h>  // For realloc, free
+
+/* -------------------------------------------------------------------------- */
+
+/// @file typedvector.h
+/// @brief Type-specialized vectors generated by macro.
+///
+/// OC_VECTOR_DEFINE() instantiates a vector struct and its functions for one
+/// element type. Unlike oc_vector_t, the element size is a compile-time
+/// constant and the struct is visible, so element access compiles to plain
+/// loads and stores and loops over name_data() can be vectorized. Unlike
+/// dynarray.h, the vector is a named struct with a function API.
+///
+/// USAGE:
+/// OC_VECTOR_DEFINE(ivec, int)
+///
+/// ivec_t v = {0};                  // Or ivec_init(&v)
+/// for (int i = 0; i < 100; ++i)
+///   ivec_push(&v, i);
+/// int sum = 0;
+/// for (size_t i = 0; i < ivec_size(&v); ++i)
+///   sum += *ivec_at(&v, i);
+/// oc_vector_t* opaque = ivec_to_vector(&v);  // Hand over, no copy
+/// ivec_free(&v);
+///
+/// Each instantiation `name` defines the struct `name_t` with public fields
+/// `data`, `size` and `capacity`, and (all `static inline`):
+/// - name_init(v)                Makes an empty vector.
+/// - name_free(v)                Frees the storage; v is empty afterwards.
+/// - name_reserve(v, cap)        Grows the capacity to at least cap.
+/// - name_push(v, x)             Appends x; grows by doubling.
+/// - name_pop(v)                 Removes and returns the last element.
+/// - name_at(v, i)               Const pointer to element i (asserted in
+///                               range); name_at_mut(v, i) for writes.
+/// - name_data(v), name_size(v)  The storage and the element count.
+/// - name_clear(v)               Drops all elements, keeps the capacity.
+/// - name_from_vector(v, vec)    Takes over an oc_vector_t's buffer.
+/// - name_to_vector(v)           Hands the buffer over to a new oc_vector_t.
+///
+/// The conversions move the buffer without copying, so typed and opaque code
+/// can share data: build it with name_push() in a hot loop, then pass it to
+/// an API that takes oc_vector_t*, or the other way round.
+
+/* -------------------------------------------------------------------------- */
+
+// --- Internal Implementation Details ---
+
+// Capacity of the first allocation.
+#define OC_TYPEDVECTOR_INITIAL_CAPACITY 8
+
+/* -------------------------------------------------------------------------- */
+
+// --- Public API Macros ---
+
+/// @brief Instantiates the vector type and functions for one element type.
+/// @param name Prefix of the generated names (e.g. `ivec` -> `ivec_t`).
+/// @param type Element type; anything assignable, including structs.
+#define OC_VECTOR_DEFINE(name, type)                                           \
+  typedef struct {                                                             \
+    type* data;      /* Elements [0, size) */                                  \
+    size_t size;     /* Number of elements */                                  \
+    size_t capacity; /* Number of elements data can hold */                    \
+  } name##_t;                                                                  \
+                                                                               \
+  static inline void name##_init(name##_t* v) {                                \
+    v->data = NULL;                                                            \
+    v->size = 0;                                                               \
+    v->capacity = 0;                                                           \
+  }                                                                            \
+                                                                               \
+  static inline void name##_free(name##_t* v) {                                \
+    free(v->data);                                                             \
+    name##_init(v);                                                            \
+  }                                                                            \
+                                                                               \
+  /* Reallocates to exactly `capacity` elements, at least the size. */         \
+  static inline oc_error_code_t name##_set_capacity(name##_t* v,               \
+                                                    size_t capacity) {         \
+    if (capacity > SIZE_MAX / sizeof(type))                                    \
+      return OC_ERROR_ALLOC;                                                   \
+    type* data = (type*)realloc(v->data, capacity * sizeof(type));             \
+    if (!data)                                                                 \
+      return OC_ERROR_ALLOC;                                                   \
+    v->data = data;                                                            \
+    v->capacity = capacity;                                                    \
+    return OC_SUCCESS;                                                         \
+  }                                                                            \
+                                                                               \
+  static inline oc_error_code_t name##_reserve(name##_t* v, size_t capacity) { \
+    return capacity <= v->capacity ? OC_SUCCESS                                \
+                                   : name##_set_capacity(v, capacity);         \
+  }                                                                            \
+                                                                               \
+  /* The rarely taken path of name_push(). */                                  \
+  static inline oc_error_code_t name##_grow(name##_t* v) {                     \
+    if (v->capacity == 0)                                                      \
+      return name##_set_capacity(v, OC_TYPEDVECTOR_INITIAL_CAPACITY);          \
+    if (v->capacity > SIZE_MAX / 2)                                            \
+      return OC_ERROR_ALLOC;                                                   \
+    return name##_set_capacity(v, v->capacity << 1);                           \
+  }                                                                            \
+                                                                               \
+  static inline oc_error_code_t name##_push(name##_t* v, type x) {             \
+    if (v->size == v->capacity) {                                              \
+      oc_error_code_t err = name##_grow(v);                                    \
+      if (err != OC_SUCCESS)                                                   \
+        return err;                                                            \
+    }                                                                          \
+    v->data[v->size++] = x;                                                    \
+    return OC_SUCCESS;                                                         \
+  }                                                                            \
+                                                                               \
+  static inline type name##_pop(name##_t* v) {                                 \
+    assert(v->size > 0 && "[OmniC][Vector] Pop from empty vector");            \
+    return v->data[--v->size];                                                 \
+  }                                                                            \
+                                                                               \
+  static inline const type* name##_at(const name##_t* v, size_t i) {           \
+    assert(i < v->size && "[OmniC][Vector] Index out of bounds");              \
+    return &v->data[i];                                                        \
+  }                                                                            \
+                                                                               \
+  static inline type* name##_at_mut(name##_t* v, size_t i) {                   \
+    assert(i < v->size && "[OmniC][Vector] Index out of bounds");              \
+    return &v->data[i];                                                        \
+  }                                                                            \
+                                                                               \
+  static inline type* name##_data(name##_t* v) { return v->data; }             \
+                                                                               \
+  static inline size_t name##_size(const name##_t* v) { return v->size; }      \
+                                                                               \
+  static inline void name##_clear(name##_t* v) { v->size = 0; }                \
+                                                                               \
+  /* Frees v's storage and takes over vec's buffer; vec is destroyed. Fails    \
+   * with OC_ERROR_INVALID_ARG if the element sizes differ or vec does not     \
+   * use the default allocator, or with OC_ERROR_ALLOC if vec's inline         \
+   * elements cannot be copied out, changing nothing. */                       \
+  static inline oc_error_code_t name##_from_vector(name##_t* v,                \
+                                                   oc_vector_t* vec) {         \
+    if (!vec || oc_vector_element_size(vec) != sizeof(type) ||                 \
+        oc_vector_allocator(vec) != oc_allocator_default())                    \
+      return OC_ERROR_INVALID_ARG;                                             \
+    void* data;                                                                \
+    size_t size, capacity;                                                     \
+    oc_error_code_t err = oc_vector_release(vec, &data, &size, &capacity);     \
+    if (err != OC_SUCCESS)                                                     \
+      return err;                                                              \
+    free(v->data);                                                             \
+    v->data = (type*)data;                                                     \
+    v->size = size;                                                            \
+    v->capacity = capacity;                                                    \
+    return OC_SUCCESS;                                                         \
+  }                                                                            \
+                                                                               \
+  /* Moves v's buffer into a new oc_vector_t and leaves v empty. Returns       \
+   * NULL, leaving v untouched, if the vector cannot be allocated. */          \
+  static inline oc_vector_t* name##_to_vector(name##_t* v) {                   \
+    oc_vector_t* vec = oc_vector_create_from_buffer(sizeof(type), v->data,     \
+                                                    v->size, v->capacity);     \
+    if (vec)                                                                   \
+      name##_init(v);                                                          \
+    return vec;                                                                \
+  }
+
+#endif  // OMNIC_TYPEDVECTOR_H_
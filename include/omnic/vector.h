@@ -3,6 +3,7 @@
 #ifndef OMNIC_VECTOR_H
 #define OMNIC_VECTOR_H
 
+#include <omnic/allocator.h>
 #include <omnic/common.h>
 
 /* -------------------------------------------------------------------------- */
@@ -18,21 +19,128 @@
 // This is the core of C-style encapsulation.
 typedef struct oc_vector oc_vector_t;
 
+/// Bytes reserved for the vector's bookkeeping in front of its inline
+/// buffer; a multiple of the alignment of max_align_t.
+#define OC_VECTOR_HEADER_SIZE 64
+
+/// Bytes of caller storage for oc_vector_init_inline() that hold `count`
+/// elements of `element_size` bytes inline.
+#define OC_VECTOR_INLINE_BYTES(element_size, count) \
+  (OC_VECTOR_HEADER_SIZE + (element_size) * (count))
+
 /* -------------------------------------------------------------------------- */
 
 /// @brief Creates a new vector.
 ///
+/// The first 8 elements are stored inline, in the same allocation as the
+/// vector itself (see oc_vector_create_small()).
+///
 /// @param element_size
 ///        The size in bytes of a single element (e.g., sizeof(int)).
 /// @return A pointer to the newly created vector, or NULL on allocation failure.
 oc_vector_t* oc_vector_create(size_t element_size);
 
+/// @brief Creates a vector that allocates through `allocator`.
+///
+/// The vector's own block, with 8 inline elements as in oc_vector_create(),
+/// and any heap buffer come from the allocator. It must outlive the vector.
+///
+/// @param element_size The size in bytes of a single element.
+/// @param allocator The allocator, or NULL for oc_allocator_default().
+/// @return The new vector, or NULL on invalid arguments or allocation
+///         failure.
+oc_vector_t* oc_vector_create_with_allocator(size_t element_size,
+                                             const oc_allocator_t* allocator);
+
+/// @brief Creates a vector with a small-buffer optimization.
+///
+/// The vector and an inline buffer for `inline_capacity` elements share
+/// one allocation. Elements stay in the inline buffer until it is full;
+/// only then is a separate heap buffer allocated, so a vector that never
+/// outgrows the inline capacity costs a single malloc().
+///
+/// @param element_size The size in bytes of a single element.
+/// @param inline_capacity The number of elements stored inline; may be 0.
+/// @return The new vector, or NULL on invalid arguments or allocation
+///         failure.
+oc_vector_t* oc_vector_create_small(size_t element_size,
+                                    size_t inline_capacity);
+
+/// @brief Places a vector in caller-provided storage, e.g. on the stack.
+///
+/// The storage holds the vector and an inline buffer for as many elements
+/// as fit; no heap memory is used until they outgrow it. The heap buffer
+/// then comes from the default allocator. The storage must
+/// stay valid, and must not be moved, until oc_vector_destroy(), which then
+/// frees only the heap buffer, if any.
+///
+/// _Alignas(max_align_t) unsigned char storage[
+///     OC_VECTOR_INLINE_BYTES(sizeof(int), 16)];
+/// oc_vector_t* vec = oc_vector_init_inline(storage, sizeof(storage),
+///                                          sizeof(int));
+///
+/// @param storage The memory to use, aligned for max_align_t.
+/// @param storage_size Its size, at least OC_VECTOR_HEADER_SIZE bytes.
+/// @param element_size The size in bytes of a single element.
+/// @return The vector (at the start of storage), or NULL if the storage is
+///         too small or misaligned or element_size is 0.
+oc_vector_t* oc_vector_init_inline(void* storage, size_t storage_size,
+                                   size_t element_size);
+
+/// @brief Creates a vector that takes ownership of an existing buffer.
+///
+/// No data is copied. The vector uses the default allocator, so the buffer
+/// must come from malloc() or realloc(), as the vector may later realloc()
+/// or free() it.
+///
+/// @param element_size The size in bytes of a single element.
+/// @param data The buffer; may be NULL if capacity is 0.
+/// @param size The number of elements already in the buffer.
+/// @param capacity The number of elements the buffer can hold.
+/// @return The new vector, or NULL on invalid arguments or allocation
+///         failure (the buffer then still belongs to the caller).
+oc_vector_t* oc_vector_create_from_buffer(size_t element_size, void* data,
+                                          size_t size, size_t capacity);
+
+/// @brief Destroys a vector but hands its buffer to the caller.
+///
+/// The counterpart of oc_vector_create_from_buffer(): the caller becomes
+/// responsible for freeing the returned buffer through the vector's
+/// allocator (query oc_vector_allocator() before releasing), which is
+/// free() for the default one. Elements held in an inline buffer are first
+/// copied to a new heap buffer of exactly their size.
+///
+/// @param vec The vector to release.
+/// @param data Receives the buffer; NULL if the vector holds no elements
+///             and no heap buffer.
+/// @param size Receives the number of elements; may be NULL.
+/// @param capacity Receives the buffer's capacity in elements; may be NULL.
+/// @return OC_SUCCESS; OC_ERROR_INVALID_ARG if vec or data is NULL; or
+///         OC_ERROR_ALLOC if inline elements cannot be copied out, in
+///         which case the vector is left intact.
+oc_error_code_t oc_vector_release(oc_vector_t* vec, void** data, size_t* size,
+                                  size_t* capacity);
+
 /// @brief Destroys a vector and frees all associated memory.
 ///
 /// @param vec A pointer to the vector to be destroyed.
 ///            If NULL, the function does nothing.
 void oc_vector_destroy(oc_vector_t* vec);
 
+/// @brief Checks whether the elements live in the inline buffer.
+///
+/// @param vec A pointer to the vector.
+/// @return True if the vector has an inline buffer and has not spilled to
+///         the heap; false otherwise or if vec is NULL.
+bool oc_vector_is_inline(const oc_vector_t* vec);
+
+/// @brief Gets the allocator the vector draws its memory from.
+///
+/// @param vec A pointer to the vector.
+/// @return The allocator (oc_allocator_default() unless one was given at
+///         creation), or NULL if vec is NULL.
+const oc_allocator_t* oc_vector_allocator(const oc_vector_t* vec);
+
 /// @brief Appends an element to the end of the vector.
 ///
 /// The vector will automatically resize if its capacity is exceeded.
@@ -63,4 +171,110 @@ size_t oc_vector_size(const oc_vector_t* vec);
 /// @return The current capacity.
 size_t oc_vector_capacity(const oc_vector_t* vec);
 
+/// @brief Gets the size in bytes of one element.
+///
+/// @param vec A pointer to the vector.
+/// @return The element size given at creation, or 0 if vec is NULL.
+size_t oc_vector_element_size(const oc_vector_t* vec);
+
+/// @brief Returns the vector's contiguous storage.
+///
+/// Element i lives at byte offset i * element_size. The pointer may be
+/// NULL for an empty vector and is only valid until the next operation
+/// that changes the capacity.
+///
+/// @param vec A pointer to the vector.
+/// @return The first element, or NULL if vec is NULL.
+void* oc_vector_data(oc_vector_t* vec);
+
+/// @brief Makes the capacity at least `capacity` elements.
+///
+/// Never shrinks. Reserving up front lets a known number of push_back or
+/// append calls run without reallocating.
+///
+/// @param vec A pointer to the vector.
+/// @param capacity The minimum capacity in elements.
+/// @return OC_SUCCESS, OC_ERROR_INVALID_ARG if vec is NULL, or
+///         OC_ERROR_ALLOC if the buffer cannot be grown.
+oc_error_code_t oc_vector_reserve(oc_vector_t* vec, size_t capacity);
+
+/// @brief Appends `count` elements with a single copy.
+///
+/// @param vec A pointer to the vector.
+/// @param elements The elements to copy; may be NULL if count is 0. Must
+///                 not point into the vector itself.
+/// @param count The number of elements.
+/// @return OC_SUCCESS, OC_ERROR_INVALID_ARG, or OC_ERROR_ALLOC. The vector
+///         is unchanged on failure.
+oc_error_code_t oc_vector_append_n(oc_vector_t* vec, const void* elements,
+                                   size_t count);
+
+/// @brief Inserts `count` elements before position `index`.
+///
+/// The tail is moved with one memmove and the new elements copied with one
+/// memcpy.
+///
+/// @param vec A pointer to the vector.
+/// @param index The insert position, at most the size.
+/// @param elements The elements to copy; may be NULL if count is 0. Must
+///                 not point into the vector itself.
+/// @param count The number of elements.
+/// @return OC_SUCCESS, OC_ERROR_INVALID_ARG, OC_ERROR_OUT_OF_BOUNDS if
+///         index exceeds the size, or OC_ERROR_ALLOC. The vector is
+///         unchanged on failure.
+oc_error_code_t oc_vector_insert_range(oc_vector_t* vec, size_t index,
+                                       const void* elements, size_t count);
+
+/// @brief Removes the elements [index, index + count).
+///
+/// The tail is moved down with one memmove; the capacity is kept.
+///
+/// @param vec A pointer to the vector.
+/// @param index The first element to remove.
+/// @param count The number of elements to remove.
+/// @return OC_SUCCESS, OC_ERROR_INVALID_ARG if vec is NULL, or
+///         OC_ERROR_OUT_OF_BOUNDS if the range exceeds the size.
+oc_error_code_t oc_vector_erase_range(oc_vector_t* vec, size_t index,
+                                      size_t count);
+
+/// @brief Sets the number of elements.
+///
+/// Shrinking drops the elements past `new_size` and keeps the capacity.
+/// Growing appends copies of `fill`, or zero bytes if fill is NULL.
+///
+/// @param vec A pointer to the vector.
+/// @param new_size The new number of elements.
+/// @param fill The element to copy into new slots, or NULL. Must not
+///             point into the vector itself.
+/// @return OC_SUCCESS, OC_ERROR_INVALID_ARG if vec is NULL, or
+///         OC_ERROR_ALLOC if the buffer cannot be grown.
+oc_error_code_t oc_vector_resize(oc_vector_t* vec, size_t new_size,
+                                 const void* fill);
+
+/// @brief Releases the capacity beyond the current size.
+///
+/// A heap buffer is freed once the elements fit the inline buffer again,
+/// and they move back into it. Without an inline buffer an empty vector
+/// frees its buffer; the next insertion allocates again.
+///
+/// @param vec A pointer to the vector.
+/// @return OC_SUCCESS, OC_ERROR_INVALID_ARG if vec is NULL, or
+///         OC_ERROR_ALLOC if the reallocation fails, in which case the
+///         vector is unchanged.
+oc_error_code_t oc_vector_shrink_to_fit(oc_vector_t* vec);
+
+/// @brief Sorts the elements in place.
+///
+/// Introsort directly on the vector's storage: O(n log n) worst case, no
+/// copy of the data. Not stable. Elements over 256 bytes borrow one
+/// element-sized temporary from the vector's allocator; if it cannot be
+/// had, the sort still completes, only with more copying.
+///
+/// @param vec A pointer to the vector.
+/// @param cmp A qsort()-style comparison: negative, zero or positive when
+///            the first element sorts before, with or after the second.
+/// @return OC_SUCCESS, or OC_ERROR_INVALID_ARG if vec or cmp is NULL.
+oc_error_code_t oc_vector_sort(oc_vector_t* vec,
+                               int (*cmp)(const void*, const void*));
+
 #endif  // OMNIC_VECTOR_H
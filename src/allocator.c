@@ -0,0 +1,31 @@
+// -*- mode: C; indent-tabs-mode: nil; c-basic-offset: 2; tab-width: 2; -*-
+
+#include <omnic/allocator.h>
+#include <stdlib.h>  // For malloc, realloc, free
+
+/* -------------------------------------------------------------------------- */
+
+// --- Default Allocator ---
+
+static void* default_alloc(void* ctx, size_t size) {
+  (void)ctx;
+  return malloc(size);
+}
+
+static void* default_realloc(void* ctx, void* ptr, size_t old_size,
+                             size_t new_size) {
+  (void)ctx;
+  (void)old_size;
+  return realloc(ptr, new_size);
+}
+
+static void default_free(void* ctx, void* ptr, size_t size) {
+  (void)ctx;
+  (void)size;
+  free(ptr);
+}
+
+static const oc_allocator_t DEFAULT_ALLOCATOR = {
+    default_alloc, default_realloc, default_free, NULL};
+
+const oc_allocator_t* oc_allocator_default(void) { return &DEFAULT_ALLOCATOR; }
@@ -0,0 +1,371 @@
+// -*- mode: C; indent-tabs-mode: nil; c-basic-offset: 2; tab-width: 2; -*-
+
+#define _POSIX_C_SOURCE 200809L  // For mkstemp, pread, ftruncate
+#define _FILE_OFFSET_BITS 64     // Inputs may exceed 2 GiB on 32-bit hosts
+
+#include "omnic/extsort.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#define ENTRY_SIZE sizeof(oc_sort_entry_t)
+
+/* -------------------------------------------------------------------------- */
+
+// --- Raw I/O ---
+// Thin loops over read/pread/write that retry short transfers and EINTR.
+
+// Reads up to `bytes`, stopping early only at end of file.
+static bool read_full(int fd, void* buf, size_t bytes, size_t* got) {
+  char* p = (char*)buf;
+  *got = 0;
+  while (*got < bytes) {
+    ssize_t r = read(fd, p + *got, bytes - *got);
+    if (r < 0 && errno == EINTR)
+      continue;
+    if (r < 0)
+      return false;
+    if (r == 0)
+      break;
+    *got += (size_t)r;
+  }
+  return true;
+}
+
+// Reads exactly `bytes` at `offset`.
+static bool pread_full(int fd, void* buf, size_t bytes, off_t offset) {
+  char* p = (char*)buf;
+  while (bytes > 0) {
+    ssize_t r = pread(fd, p, bytes, offset);
+    if (r < 0 && errno == EINTR)
+      continue;
+    if (r <= 0)
+      return false;
+    p += r;
+    bytes -= (size_t)r;
+    offset += r;
+  }
+  return true;
+}
+
+static bool write_full(int fd, const void* buf, size_t bytes) {
+  const char* p = (const char*)buf;
+  while (bytes > 0) {
+    ssize_t w = write(fd, p, bytes);
+    if (w < 0 && errno == EINTR)
+      continue;
+    if (w <= 0)
+      return false;
+    p += w;
+    bytes -= (size_t)w;
+  }
+  return true;
+}
+
+// Creates an anonymous temporary file: it is unlinked right away and lives
+// only as long as the descriptor.
+static int open_temp(const char* dir) {
+  if (!dir)
+    dir = getenv("TMPDIR");
+  if (!dir || !*dir)
+    dir = "/tmp";
+
+  char path[4096];
+  int len = snprintf(path, sizeof(path), "%s/omnic-extsort-XXXXXX", dir);
+  if (len < 0 || (size_t)len >= sizeof(path))
+    return -1;
+  int fd = mkstemp(path);
+  if (fd >= 0)
+    unlink(path);
+  return fd;
+}
+
+// --- Run Bookkeeping ---
+// Every run of a pass lives in one temporary file, so the number of open
+// descriptors stays at two however many runs there are.
+
+typedef struct {
+  off_t offset;   // Byte offset of the first record
+  size_t length;  // Number of records
+} run_t;
+
+typedef struct {
+  run_t* v;
+  size_t n;
+  size_t cap;
+} run_list_t;
+
+static bool run_list_push(run_list_t* runs, off_t offset, size_t length) {
+  if (runs->n == runs->cap) {
+    size_t cap = runs->cap ? runs->cap * 2 : 64;
+    run_t* v = (run_t*)realloc(runs->v, cap * sizeof(run_t));
+    if (!v)
+      return false;
+    runs->v = v;
+    runs->cap = cap;
+  }
+  runs->v[runs->n].offset = offset;
+  runs->v[runs->n].length = length;
+  ++runs->n;
+  return true;
+}
+
+// --- Run Merging ---
+// Runs are merged with oc_sort_merge_k_stream(): each run is a source that
+// preads the next block of its extent, the sink appends to a descriptor.
+
+typedef struct {
+  int fd;
+  off_t next;        // File offset of the first record not yet read
+  size_t remaining;  // Records of the run not yet read
+} run_source_t;
+
+static oc_error_code_t run_source_read(void* ctx, oc_sort_entry_t* buf,
+                                       size_t cap, size_t* got) {
+  run_source_t* rs = (run_source_t*)ctx;
+  size_t n = rs->remaining < cap ? rs->remaining : cap;
+  if (n > 0 && !pread_full(rs->fd, buf, n * ENTRY_SIZE, rs->next))
+    return OC_ERROR_IO;
+  rs->next += (off_t)(n * ENTRY_SIZE);
+  rs->remaining -= n;
+  *got = n;
+  return OC_SUCCESS;
+}
+
+static oc_error_code_t fd_sink_write(void* ctx, const oc_sort_entry_t* d,
+                                     size_t n) {
+  int fd = *(const int*)ctx;
+  return write_full(fd, d, n * ENTRY_SIZE) ? OC_SUCCESS : OC_ERROR_IO;
+}
+
+// Merges k runs of in_fd and appends the result at the current position of
+// out_fd, with `io` (cap records) as the merge buffer.
+static oc_error_code_t merge_runs(int in_fd, const run_t* runs, size_t k,
+                                  int out_fd, oc_sort_entry_t* io, size_t cap,
+                                  run_source_t* rs, oc_sort_source_t* src) {
+  for (size_t i = 0; i < k; ++i) {
+    rs[i].fd = in_fd;
+    rs[i].next = runs[i].offset;
+    rs[i].remaining = runs[i].length;
+    src[i].read = run_source_read;
+    src[i].ctx = &rs[i];
+  }
+  oc_sort_sink_t sink = {fd_sink_write, &out_fd};
+  return oc_sort_merge_k_stream(src, k, &sink, io, cap);
+}
+
+// --- External Sort Driver ---
+
+// Everything a sort holds, so a single cleanup releases it on any path.
+typedef struct {
+  const oc_extsort_config_t* cfg;
+  int in_fd;
+  int out_fd;
+  int run_fd[2];  // Ping-pong run files
+  run_list_t runs[2];
+  oc_sort_entry_t* buf;
+  size_t cap;  // Records in buf
+  run_source_t* rs;
+  oc_sort_source_t* src;
+  oc_extsort_stats_t stats;
+} extsort_t;
+
+static void extsort_release(extsort_t* es) {
+  if (es->in_fd >= 0)
+    close(es->in_fd);
+  if (es->out_fd >= 0)
+    close(es->out_fd);
+  for (int i = 0; i < 2; ++i) {
+    if (es->run_fd[i] >= 0)
+      close(es->run_fd[i]);
+    free(es->runs[i].v);
+  }
+  free(es->buf);
+  free(es->rs);
+  free(es->src);
+}
+
+// Opens the output (only once the input has been read and closed, so the
+// two may be the same file), takes ownership of the descriptor in es.
+static oc_error_code_t open_output(extsort_t* es, const char* out_path) {
+  es->out_fd = open(out_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  return es->out_fd >= 0 ? OC_SUCCESS : OC_ERROR_IO;
+}
+
+static oc_error_code_t close_output(extsort_t* es) {
+  int rc = close(es->out_fd);  // Reports delayed write errors
+  es->out_fd = -1;
+  return rc == 0 ? OC_SUCCESS : OC_ERROR_IO;
+}
+
+// Phase 1: sorts memory-sized chunks and spills them as runs. An input
+// that fits in one chunk is written straight to the output instead.
+static oc_error_code_t extsort_spill(extsort_t* es, const char* out_path,
+                                     bool* done) {
+  off_t end = 0;
+  *done = false;
+  for (;;) {
+    size_t got;
+    if (!read_full(es->in_fd, es->buf, es->cap * ENTRY_SIZE, &got))
+      return OC_ERROR_IO;
+    if (got % ENTRY_SIZE != 0)
+      return OC_ERROR_INVALID_ARG;  // Truncated trailing record
+    size_t n = got / ENTRY_SIZE;
+    es->stats.records += n;
+
+    oc_sort_list_t list = oc_sort_list_view(es->buf, n);
+    if (n > 1)
+      es->cfg->sort(&list);
+
+    if (es->runs[0].n == 0 && n < es->cap) {
+      // The whole input fit in memory.
+      close(es->in_fd);
+      es->in_fd = -1;
+      oc_error_code_t err = open_output(es, out_path);
+      if (err != OC_SUCCESS)
+        return err;
+      if (!write_full(es->out_fd, es->buf, n * ENTRY_SIZE))
+        return OC_ERROR_IO;
+      *done = true;
+      return close_output(es);
+    }
+    if (n == 0)
+      break;
+
+    if (es->run_fd[0] < 0) {
+      es->run_fd[0] = open_temp(es->cfg->temp_dir);
+      if (es->run_fd[0] < 0)
+        return OC_ERROR_IO;
+    }
+    if (!write_full(es->run_fd[0], es->buf, n * ENTRY_SIZE))
+      return OC_ERROR_IO;
+    if (!run_list_push(&es->runs[0], end, n))
+      return OC_ERROR_ALLOC;
+    end += (off_t)(n * ENTRY_SIZE);
+    if (n < es->cap)
+      break;  // Short read: end of input
+  }
+
+  close(es->in_fd);
+  es->in_fd = -1;
+  es->stats.runs = es->runs[0].n;
+  return OC_SUCCESS;
+}
+
+// Phase 2: merges groups of fan_in runs from one run file into the other
+// until at most fan_in remain, then merges those into the output.
+static oc_error_code_t extsort_merge(extsort_t* es, const char* out_path) {
+  size_t fan_in = es->cfg->fan_in;
+  es->rs = (run_source_t*)malloc(fan_in * sizeof(run_source_t));
+  es->src = (oc_sort_source_t*)malloc(fan_in * sizeof(oc_sort_source_t));
+  if (!es->rs || !es->src)
+    return OC_ERROR_ALLOC;
+
+  int cur = 0;
+  while (es->runs[cur].n > fan_in) {
+    int nxt = 1 - cur;
+    if (es->run_fd[nxt] < 0) {
+      es->run_fd[nxt] = open_temp(es->cfg->temp_dir);
+      if (es->run_fd[nxt] < 0)
+        return OC_ERROR_IO;
+    } else if (ftruncate(es->run_fd[nxt], 0) != 0 ||
+               lseek(es->run_fd[nxt], 0, SEEK_SET) != 0) {
+      return OC_ERROR_IO;
+    }
+    es->runs[nxt].n = 0;
+
+    off_t end = 0;
+    const run_list_t* in = &es->runs[cur];
+    for (size_t g = 0; g < in->n; g += fan_in) {
+      size_t k = in->n - g < fan_in ? in->n - g : fan_in;
+      size_t length = 0;
+      for (size_t i = 0; i < k; ++i)
+        length += in->v[g + i].length;
+
+      oc_error_code_t err = merge_runs(es->run_fd[cur], in->v + g, k,
+                                       es->run_fd[nxt], es->buf, es->cap,
+                                       es->rs, es->src);
+      if (err != OC_SUCCESS)
+        return err;
+      if (!run_list_push(&es->runs[nxt], end, length))
+        return OC_ERROR_ALLOC;
+      end += (off_t)(length * ENTRY_SIZE);
+    }
+    ++es->stats.merge_passes;
+    cur = nxt;
+  }
+
+  oc_error_code_t err = open_output(es, out_path);
+  if (err != OC_SUCCESS)
+    return err;
+  size_t k = es->runs[cur].n;
+  err = merge_runs(es->run_fd[cur], es->runs[cur].v, k, es->out_fd, es->buf,
+                   es->cap, es->rs, es->src);
+  if (err != OC_SUCCESS)
+    return err;
+  ++es->stats.merge_passes;
+  return close_output(es);
+}
+
+oc_extsort_config_t oc_extsort_default_config(void) {
+  oc_extsort_config_t cfg = {OC_EXTSORT_DEFAULT_MEMORY_LIMIT,
+                             OC_EXTSORT_DEFAULT_FAN_IN, NULL, NULL};
+  return cfg;
+}
+
+oc_error_code_t oc_extsort_file(const char* in_path, const char* out_path,
+                                const oc_extsort_config_t* config,
+                                oc_extsort_stats_t* stats) {
+  oc_extsort_config_t cfg =
+      config ? *config : oc_extsort_default_config();
+  if (!cfg.sort)
+    cfg.sort = oc_sort_pdq;
+  // Each merge needs at least one record of buffer per run plus the output.
+  if (!in_path || !out_path || cfg.fan_in < 2 ||
+      cfg.memory_limit / ENTRY_SIZE < cfg.fan_in + 1) {
+    return OC_ERROR_INVALID_ARG;
+  }
+
+  extsort_t es;
+  memset(&es, 0, sizeof(es));
+  es.cfg = &cfg;
+  es.in_fd = es.out_fd = es.run_fd[0] = es.run_fd[1] = -1;
+
+  oc_error_code_t err = OC_SUCCESS;
+  es.in_fd = open(in_path, O_RDONLY);
+  if (es.in_fd < 0)
+    err = OC_ERROR_IO;
+
+  if (err == OC_SUCCESS) {
+    // Don't reserve the whole budget for a small file; one spare record
+    // lets the first read come up short, which marks the in-memory case.
+    es.cap = cfg.memory_limit / ENTRY_SIZE;
+    struct stat st;
+    if (fstat(es.in_fd, &st) == 0 && S_ISREG(st.st_mode)) {
+      size_t records = (size_t)st.st_size / ENTRY_SIZE;
+      if (records < es.cap)
+        es.cap = records + 1 > cfg.fan_in + 1 ? records + 1 : cfg.fan_in + 1;
+    }
+    es.buf = (oc_sort_entry_t*)malloc(es.cap * ENTRY_SIZE);
+    if (!es.buf)
+      err = OC_ERROR_ALLOC;
+  }
+
+  bool done = false;
+  if (err == OC_SUCCESS)
+    err = extsort_spill(&es, out_path, &done);
+  if (err == OC_SUCCESS && !done)
+    err = extsort_merge(&es, out_path);
+
+  if (err == OC_SUCCESS && stats)
+    *stats = es.stats;
+  extsort_release(&es);
+  return err;
+}
@@ -0,0 +1,149 @@
+// -*- mode: C; indent-tabs-mode: nil; c-basic-offset: 2; tab-width: 2; -*-
+
+#define _DEFAULT_SOURCE  // For syscall
+
+#include "omnic/perfcount.h"
+
+#include <string.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+static const char* const EVENT_NAMES[OC_PERF_EVENT_COUNT] = {
+    "cycles",     "instructions", "branch-misses",
+    "l1d-misses", "llc-misses",   "dtlb-misses"};
+
+const char* oc_perf_event_name(oc_perf_event_t event) {
+  return event < OC_PERF_EVENT_COUNT ? EVENT_NAMES[event] : "unknown";
+}
+
+bool oc_perf_available(const oc_perf_counters_t* pc, oc_perf_event_t event) {
+  return event < OC_PERF_EVENT_COUNT && pc->fd[event] >= 0;
+}
+
+#ifdef __linux__
+
+// --- Linux perf_event_open ---
+
+#define CACHE_READ_MISS(cache)                                     \
+  ((cache) | (PERF_COUNT_HW_CACHE_OP_READ << 8) |                  \
+   (PERF_COUNT_HW_CACHE_RESULT_MISS << 16))
+
+// perf_event_attr type and config of every event.
+static const struct {
+  uint32_t type;
+  uint64_t config;
+} EVENTS[OC_PERF_EVENT_COUNT] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HW_CACHE, CACHE_READ_MISS(PERF_COUNT_HW_CACHE_L1D)},
+    {PERF_TYPE_HW_CACHE, CACHE_READ_MISS(PERF_COUNT_HW_CACHE_LL)},
+    {PERF_TYPE_HW_CACHE, CACHE_READ_MISS(PERF_COUNT_HW_CACHE_DTLB)}};
+
+// read() with the two time fields requested in read_format returns value,
+// time enabled and time running.
+static bool read_event(int fd, uint64_t reading[3]) {
+  return read(fd, reading, 3 * sizeof(uint64_t)) ==
+         (ssize_t)(3 * sizeof(uint64_t));
+}
+
+size_t oc_perf_open(oc_perf_counters_t* pc) {
+  size_t opened = 0;
+  memset(pc->base, 0, sizeof(pc->base));
+  for (int e = 0; e < OC_PERF_EVENT_COUNT; ++e) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = EVENTS[e].type;
+    attr.config = EVENTS[e].config;
+    attr.disabled = 1;
+    attr.inherit = 1;  // Count the worker threads of parallel sorts too
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format =
+        PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    pc->fd[e] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    if (pc->fd[e] < 0)
+      pc->fd[e] = -1;
+    else
+      ++opened;
+  }
+  return opened;
+}
+
+// Counts of exited inherited threads are folded into the parent and survive
+// PERF_EVENT_IOC_RESET, so regions are measured as differences of readings.
+void oc_perf_start(oc_perf_counters_t* pc) {
+  for (int e = 0; e < OC_PERF_EVENT_COUNT; ++e) {
+    if (pc->fd[e] >= 0 && !read_event(pc->fd[e], pc->base[e]))
+      memset(pc->base[e], 0, sizeof(pc->base[e]));
+  }
+  for (int e = 0; e < OC_PERF_EVENT_COUNT; ++e) {
+    if (pc->fd[e] >= 0)
+      ioctl(pc->fd[e], PERF_EVENT_IOC_ENABLE, 0);
+  }
+}
+
+void oc_perf_stop(oc_perf_counters_t* pc, oc_perf_sample_t* sample) {
+  for (int e = 0; e < OC_PERF_EVENT_COUNT; ++e) {
+    if (pc->fd[e] >= 0)
+      ioctl(pc->fd[e], PERF_EVENT_IOC_DISABLE, 0);
+  }
+  for (int e = 0; e < OC_PERF_EVENT_COUNT; ++e) {
+    uint64_t r[3];
+    sample->value[e] = 0;
+    sample->valid[e] = pc->fd[e] >= 0 && read_event(pc->fd[e], r);
+    if (!sample->valid[e])
+      continue;
+    uint64_t value = r[0] - pc->base[e][0];
+    uint64_t enabled = r[1] - pc->base[e][1];
+    uint64_t running = r[2] - pc->base[e][2];
+    // With more events than hardware counters the kernel time-slices them;
+    // extrapolate to the whole region. An event that never ran is unknown.
+    sample->valid[e] = running > 0;
+    if (running > 0 && running < enabled)
+      value = (uint64_t)((double)value * (double)enabled / (double)running);
+    sample->value[e] = running > 0 ? value : 0;
+  }
+}
+
+void oc_perf_close(oc_perf_counters_t* pc) {
+  for (int e = 0; e < OC_PERF_EVENT_COUNT; ++e) {
+    if (pc->fd[e] >= 0)
+      close(pc->fd[e]);
+    pc->fd[e] = -1;
+  }
+}
+
+#else
+
+// --- Unsupported Platforms ---
+
+size_t oc_perf_open(oc_perf_counters_t* pc) {
+  memset(pc, 0, sizeof(*pc));
+  for (int e = 0; e < OC_PERF_EVENT_COUNT; ++e)
+    pc->fd[e] = -1;
+  return 0;
+}
+
+void oc_perf_start(oc_perf_counters_t* pc) {
+  (void)pc;
+}
+
+void oc_perf_stop(oc_perf_counters_t* pc, oc_perf_sample_t* sample) {
+  (void)pc;
+  memset(sample, 0, sizeof(*sample));
+}
+
+void oc_perf_close(oc_perf_counters_t* pc) {
+  (void)pc;
+}
+
+#endif  // __linux__
@@ -0,0 +1,216 @@
+// -*- mode: C; indent-tabs-mode: nil; c-basic-offset: 2; tab-width: 2; -*-
+
+#include <limits.h>  // For CHAR_BIT
+#include <omnic/segvector.h>
+#include <stdint.h>  // For SIZE_MAX
+#include <string.h>  // For memcpy
+
+// Blocks needed to address every index representable in size_t.
+#define MAX_BLOCKS (sizeof(size_t) * CHAR_BIT - OC_SEGVECTOR_FIRST_BLOCK_SHIFT)
+
+/* -------------------------------------------------------------------------- */
+
+// --- Struct Definition ---
+// Block k holds OC_SEGVECTOR_FIRST_BLOCK << k elements. The table never
+// grows, so growing the vector only ever allocates one new block.
+struct oc_segvector {
+  char* blocks[MAX_BLOCKS];         // The first num_blocks are allocated
+  size_t num_blocks;                // Number of allocated blocks
+  size_t element_size;              // Size of each element in bytes
+  size_t size;                      // Number of elements in the vector
+  const oc_allocator_t* allocator;  // Source of the blocks and the struct
+};
+
+/* -------------------------------------------------------------------------- */
+
+// --- Index Mapping ---
+
+// floor(log2(x)) for x > 0.
+static inline unsigned floor_log2(size_t x) {
+#if defined(__GNUC__)
+  return (unsigned)(sizeof(unsigned long long) * CHAR_BIT - 1) -
+         (unsigned)__builtin_clzll((unsigned long long)x);
+#else
+  unsigned r = 0;
+  while (x >>= 1)
+    ++r;
+  return r;
+#endif
+}
+
+// Elements in block k.
+static inline size_t block_capacity(size_t k) {
+  return OC_SEGVECTOR_FIRST_BLOCK << k;
+}
+
+// Elements in blocks [0, k): OC_SEGVECTOR_FIRST_BLOCK * (2^k - 1).
+static inline size_t blocks_capacity(size_t k) {
+  return block_capacity(k) - OC_SEGVECTOR_FIRST_BLOCK;
+}
+
+// Block holding element i: the blocks before block k hold F * (2^k - 1)
+// elements, with F = OC_SEGVECTOR_FIRST_BLOCK, so k = floor(log2(i / F + 1)).
+static inline size_t block_of(size_t i) {
+  return floor_log2((i >> OC_SEGVECTOR_FIRST_BLOCK_SHIFT) + 1);
+}
+
+static inline char* element_at(const oc_segvector_t* vec, size_t i) {
+  size_t k = block_of(i);
+  return vec->blocks[k] + (i - blocks_capacity(k)) * vec->element_size;
+}
+
+/* -------------------------------------------------------------------------- */
+
+// --- Lifecycle ---
+
+oc_segvector_t* oc_segvector_create(size_t element_size) {
+  return oc_segvector_create_with_allocator(element_size, NULL);
+}
+
+oc_segvector_t* oc_segvector_create_with_allocator(
+    size_t element_size, const oc_allocator_t* allocator) {
+  if (element_size == 0) {
+    return NULL;
+  }
+  if (!allocator) {
+    allocator = oc_allocator_default();
+  }
+
+  oc_segvector_t* vec = oc_allocator_alloc(allocator, sizeof(oc_segvector_t));
+  if (!vec) {
+    return NULL;
+  }
+  vec->num_blocks = 0;
+  vec->element_size = element_size;
+  vec->size = 0;
+  vec->allocator = allocator;
+  return vec;
+}
+
+void oc_segvector_destroy(oc_segvector_t* vec) {
+  if (!vec) {
+    return;
+  }
+  for (size_t k = 0; k < vec->num_blocks; ++k) {
+    oc_allocator_free(vec->allocator, vec->blocks[k],
+                      block_capacity(k) * vec->element_size);
+  }
+  oc_allocator_free(vec->allocator, vec, sizeof(oc_segvector_t));
+}
+
+// Allocates the next block.
+static oc_error_code_t add_block(oc_segvector_t* vec) {
+  size_t k = vec->num_blocks;
+  // The capacity after this block, F * (2^(k+1) - 1), must fit in size_t.
+  if (k + 1 >= MAX_BLOCKS ||
+      block_capacity(k) > SIZE_MAX / vec->element_size) {
+    return OC_ERROR_ALLOC;
+  }
+
+  char* block = oc_allocator_alloc(vec->allocator,
+                                   block_capacity(k) * vec->element_size);
+  if (!block) {
+    return OC_ERROR_ALLOC;
+  }
+  vec->blocks[k] = block;
+  vec->num_blocks = k + 1;
+  return OC_SUCCESS;
+}
+
+oc_error_code_t oc_segvector_reserve(oc_segvector_t* vec, size_t capacity) {
+  if (!vec) {
+    return OC_ERROR_INVALID_ARG;
+  }
+  while (blocks_capacity(vec->num_blocks) < capacity) {
+    oc_error_code_t err = add_block(vec);
+    if (err != OC_SUCCESS) {
+      return err;
+    }
+  }
+  return OC_SUCCESS;
+}
+
+/* -------------------------------------------------------------------------- */
+
+// --- Element Access and Modification ---
+
+oc_error_code_t oc_segvector_push_back(oc_segvector_t* vec,
+                                       const void* element) {
+  if (!vec || !element) {
+    return OC_ERROR_INVALID_ARG;
+  }
+
+  if (vec->size == blocks_capacity(vec->num_blocks)) {
+    oc_error_code_t err = add_block(vec);
+    if (err != OC_SUCCESS) {
+      return err;
+    }
+  }
+
+  memcpy(element_at(vec, vec->size), element, vec->element_size);
+  vec->size++;
+  return OC_SUCCESS;
+}
+
+oc_error_code_t oc_segvector_append_n(oc_segvector_t* vec,
+                                      const void* elements, size_t count) {
+  if (!vec || (!elements && count > 0)) {
+    return OC_ERROR_INVALID_ARG;
+  }
+  if (count > SIZE_MAX - vec->size) {
+    return OC_ERROR_ALLOC;
+  }
+
+  oc_error_code_t err = oc_segvector_reserve(vec, vec->size + count);
+  if (err != OC_SUCCESS) {
+    return err;
+  }
+
+  // One copy per block the new elements span.
+  const char* src = elements;
+  while (count > 0) {
+    size_t k = block_of(vec->size);
+    size_t room = blocks_capacity(k + 1) - vec->size;
+    size_t n = count < room ? count : room;
+    memcpy(element_at(vec, vec->size), src, n * vec->element_size);
+    src += n * vec->element_size;
+    vec->size += n;
+    count -= n;
+  }
+  return OC_SUCCESS;
+}
+
+const void* oc_segvector_get(const oc_segvector_t* vec, size_t index) {
+  if (!vec || index >= vec->size) {
+    return NULL;
+  }
+  return element_at(vec, index);
+}
+
+void* oc_segvector_contiguous(oc_segvector_t* vec, size_t index,
+                              size_t* count) {
+  if (!vec || index >= vec->size) {
+    if (count) {
+      *count = 0;
+    }
+    return NULL;
+  }
+
+  if (count) {
+    size_t block_end = blocks_capacity(block_of(index) + 1);
+    *count = (block_end < vec->size ? block_end : vec->size) - index;
+  }
+  return element_at(vec, index);
+}
+
+size_t oc_segvector_size(const oc_segvector_t* vec) {
+  return vec ? vec->size : 0;
+}
+
+size_t oc_segvector_capacity(const oc_segvector_t* vec) {
+  return vec ? blocks_capacity(vec->num_blocks) : 0;
+}
+
+size_t oc_segvector_element_size(const oc_segvector_t* vec) {
+  return vec ? vec->element_size : 0;
+}
@@ -1,9 +1,28 @@
 // -*- mode: C; indent-tabs-mode: nil; c-basic-offset: 2; tab-width: 2; -*-
 
 #include "omnic/sorting.h"
+#include "omnic/sortnet.h"
 
+#include <limits.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <unistd.h>  // For sysconf
+
+// Ranges at or above this size pick the quick sort pivot with a ninther.
+#define OC_SORT_NINTHER_THRESHOLD 128
+// Ranges at or below this size are finished with insertion sort when the
+// SIMD network is not in use.
+#define OC_SORT_INSERTION_CUTOFF 16
+// Run length insertion-sorted before the bottom-up merge passes when the
+// SIMD network is not in use; with it, runs are OC_SORTNET_MAX long.
+#define OC_SORT_MERGE_RUN 32
+// Smallest chunk handed to a thread by the parallel sorts.
+#define OC_SORT_PARALLEL_MIN_CHUNK 16384
 
 // Helper swap function
 static inline void swap(oc_sort_entry_t* a, oc_sort_entry_t* b) {
@@ -14,9 +33,9 @@ static inline void swap(oc_sort_entry_t* a, oc_sort_entry_t* b) {
 
 // --- Simple Selection Sort ---
 void oc_sort_selection(oc_sort_list_t* list) {
-  for (int i = 1; i < list->n; ++i) {
-    int min_idx = i;
-    for (int j = i + 1; j <= list->n; ++j) {
+  for (size_t i = 0; i + 1 < list->n; ++i) {
+    size_t min_idx = i;
+    for (size_t j = i + 1; j < list->n; ++j) {
       if (list->d[j].key < list->d[min_idx].key) {
         min_idx = j;
       }
@@ -28,24 +47,57 @@ void oc_sort_selection(oc_sort_list_t* list) {
 }
 
 // --- Direct Insertion Sort ---
-void oc_sort_insertion(oc_sort_list_t* list) {
-  for (int i = 2; i <= list->n; ++i) {
-    if (list->d[i].key < list->d[i - 1].key) {
-      list->d[0] = list->d[i];  // Use d[0] as sentinel
-      int j;
-      for (j = i - 1; list->d[0].key < list->d[j].key; --j) {
-        list->d[j + 1] = list->d[j];
-      }
-      list->d[j + 1] = list->d[0];
+// Sorts d[0]...d[n - 1]; also used as the small-range base case below.
+static void insertion_sort_range(oc_sort_entry_t* d, size_t n) {
+  for (size_t i = 1; i < n; ++i) {
+    if (d[i].key < d[i - 1].key) {
+      oc_sort_entry_t tmp = d[i];  // Hold the element instead of a sentinel
+      size_t j = i;
+      do {
+        d[j] = d[j - 1];
+        --j;
+      } while (j > 0 && tmp.key < d[j - 1].key);
+      d[j] = tmp;
     }
   }
 }
 
+void oc_sort_insertion(oc_sort_list_t* list) {
+  insertion_sort_range(list->d, list->n);
+}
+
+// --- Small-Range Base Cases ---
+// The SIMD sorting network beats insertion sort on up to OC_SORTNET_MAX
+// entries, but its scalar fallback runs the whole padded network and loses
+// to insertion sort on the short ranges it would get; so the network is
+// only used, with its larger cutoff, while the SIMD path is active.
+
+// Largest range the recursive sorts hand to small_sort().
+static inline size_t small_sort_cutoff(void) {
+  return oc_sortnet_simd_enabled() ? OC_SORTNET_MAX : OC_SORT_INSERTION_CUTOFF;
+}
+
+// Sorts d[0..n), n <= OC_SORTNET_MAX. Not stable.
+static inline void small_sort(oc_sort_entry_t* d, size_t n) {
+  if (oc_sortnet_simd_enabled())
+    oc_sortnet_entries(d, n);
+  else
+    insertion_sort_range(d, n);
+}
+
+// Sorts d[0..n), n <= OC_SORTNET_MAX, keeping equal keys in input order.
+static inline void small_sort_stable(oc_sort_entry_t* d, size_t n) {
+  if (oc_sortnet_simd_enabled())
+    oc_sortnet_entries_stable(d, n);
+  else
+    insertion_sort_range(d, n);
+}
+
 // --- Bubble Sort ---
 void oc_sort_bubble(oc_sort_list_t* list) {
-  for (int i = 1; i < list->n; ++i) {
+  for (size_t i = 1; i < list->n; ++i) {
     int swapped = 0;
-    for (int j = 1; j <= list->n - i; ++j) {
+    for (size_t j = 0; j < list->n - i; ++j) {
       if (list->d[j].key > list->d[j + 1].key) {
         swap(&list->d[j], &list->d[j + 1]);
         swapped = 1;
@@ -56,55 +108,444 @@ void oc_sort_bubble(oc_sort_list_t* list) {
   }
 }
 
-// --- Quick Sort ---
-static int partition(oc_sort_list_t* list, int low, int high) {
-  list->d[0] = list->d[low];  // Use d[0] as pivot backup
-  oc_key_type_t pivot_key = list->d[low].key;
-  while (low < high) {
-    while (low < high && list->d[high].key >= pivot_key)
-      --high;
-    list->d[low] = list->d[high];
-    while (low < high && list->d[low].key <= pivot_key)
-      ++low;
-    list->d[high] = list->d[low];
+// --- Quick Sort (Introsort) ---
+static void heap_sort_range(oc_sort_entry_t* d, size_t n);
+
+// Returns the index (a, b or c) holding the median of the three keys.
+static inline size_t median3(const oc_sort_entry_t* d, size_t a, size_t b,
+                             size_t c) {
+  if (d[a].key < d[b].key) {
+    if (d[b].key < d[c].key)
+      return b;
+    return d[a].key < d[c].key ? c : a;
+  }
+  if (d[a].key < d[c].key)
+    return a;
+  return d[b].key < d[c].key ? c : b;
+}
+
+// Picks a pivot for the closed range [low, high] and moves it to d[low].
+// Uses median-of-three, or Tukey's ninther on large ranges.
+static void choose_pivot(oc_sort_entry_t* d, size_t low, size_t high) {
+  size_t n = high - low + 1;
+  size_t mid = low + n / 2;
+  size_t m;
+  if (n >= OC_SORT_NINTHER_THRESHOLD) {
+    size_t step = n / 8;
+    size_t a = median3(d, low, low + step, low + 2 * step);
+    size_t b = median3(d, mid - step, mid, mid + step);
+    size_t c = median3(d, high - 2 * step, high - step, high);
+    m = median3(d, a, b, c);
+  } else {
+    m = median3(d, low, mid, high);
   }
-  list->d[low] = list->d[0];
-  return low;
+  swap(&d[low], &d[m]);
 }
 
-static void qsort_recursive(oc_sort_list_t* list, int low, int high) {
-  if (low < high) {
-    int pivot_loc = partition(list, low, high);
-    qsort_recursive(list, low, pivot_loc - 1);
-    qsort_recursive(list, pivot_loc + 1, high);
+// Hoare partition of the closed range [low, high] around the pivot d[low].
+// Both scans stop on keys equal to the pivot, so runs of duplicates are split
+// evenly instead of degrading to quadratic time.
+static size_t partition(oc_sort_entry_t* d, size_t low, size_t high) {
+  oc_key_type_t pivot_key = d[low].key;
+  size_t i = low, j = high + 1;
+  for (;;) {
+    while (d[++i].key < pivot_key) {
+      if (i == high)
+        break;
+    }
+    while (pivot_key < d[--j].key) {
+      // d[low] holds the pivot, which stops the scan.
+    }
+    if (i >= j)
+      break;
+    swap(&d[i], &d[j]);
   }
+  swap(&d[low], &d[j]);
+  return j;
 }
 
-void oc_sort_quick(oc_sort_list_t* list) { qsort_recursive(list, 1, list->n); }
+// Sorts the closed range [low, high]. Recurses only into the smaller side so
+// the stack depth stays O(log n); past `depth_limit` levels the range is
+// handed to heap sort, bounding the worst case to O(n log n).
+static void introsort_loop(oc_sort_entry_t* d, size_t low, size_t high,
+                           unsigned depth_limit) {
+  size_t cutoff = small_sort_cutoff();
+  while (high - low + 1 > cutoff) {
+    if (depth_limit == 0) {
+      heap_sort_range(d + low, high - low + 1);
+      return;
+    }
+    --depth_limit;
 
-// --- Two-way Merge Sort ---
-static void merge(oc_sort_entry_t* d, oc_sort_entry_t* temp, int low, int mid,
-                  int high) {
-  int i = low, j = mid + 1, k = low;
-  while (i <= mid && j <= high) {
-    if (d[i].key <= d[j].key) {
-      temp[k++] = d[i++];
+    choose_pivot(d, low, high);
+    size_t pivot_loc = partition(d, low, high);
+    if (pivot_loc - low < high - pivot_loc) {
+      if (pivot_loc > low)
+        introsort_loop(d, low, pivot_loc - 1, depth_limit);
+      low = pivot_loc + 1;
+    } else {
+      introsort_loop(d, pivot_loc + 1, high, depth_limit);
+      high = pivot_loc - 1;
+    }
+  }
+  small_sort(d + low, high - low + 1);
+}
+
+// 2 * floor(log2(n)), the conventional introsort recursion budget.
+static unsigned introsort_depth_limit(size_t n) {
+  unsigned depth = 0;
+  while (n > 1) {
+    n >>= 1;
+    ++depth;
+  }
+  return 2 * depth;
+}
+
+void oc_sort_quick(oc_sort_list_t* list) {
+  if (list->n > 1)
+    introsort_loop(list->d, 0, list->n - 1, introsort_depth_limit(list->n));
+}
+
+// --- Pattern-defeating Quick Sort ---
+// After Orson Peters' pdqsort. Partitioning classifies elements a block at a
+// time into offset buffers, with the comparison result added to a counter
+// rather than branched on, and then swaps the misplaced pairs. Highly
+// unbalanced partitions shuffle a few elements to break patterns and count
+// towards a heap sort fallback; partitions that needed no swaps are finished
+// with a bounded insertion sort, which makes sorted input linear. Small
+// ranges are sorted with the network kernel while the SIMD path is active
+// and with insertion sort otherwise.
+
+#define OC_SORT_PDQ_SMALL_THRESHOLD 24
+#define OC_SORT_PDQ_BLOCK_SIZE 64
+#define OC_SORT_PDQ_PARTIAL_LIMIT 8
+
+static inline void pdq_sort2(oc_sort_entry_t* a, oc_sort_entry_t* b) {
+  if (b->key < a->key)
+    swap(a, b);
+}
+
+static inline void pdq_sort3(oc_sort_entry_t* a, oc_sort_entry_t* b,
+                             oc_sort_entry_t* c) {
+  pdq_sort2(a, b);
+  pdq_sort2(b, c);
+  pdq_sort2(a, b);
+}
+
+// Insertion sort that relies on begin[-1] not exceeding any key in the range.
+static void pdq_unguarded_insertion_sort(oc_sort_entry_t* begin,
+                                         oc_sort_entry_t* end) {
+  for (oc_sort_entry_t* cur = begin + 1; cur < end; ++cur) {
+    oc_sort_entry_t* sift = cur;
+    oc_sort_entry_t* sift_1 = cur - 1;
+    if (sift->key < sift_1->key) {
+      oc_sort_entry_t tmp = *sift;
+      do {
+        *sift-- = *sift_1;
+      } while (tmp.key < (--sift_1)->key);
+      *sift = tmp;
+    }
+  }
+}
+
+// Insertion sort that gives up (returning 0) once more than
+// OC_SORT_PDQ_PARTIAL_LIMIT elements have been moved.
+static int pdq_partial_insertion_sort(oc_sort_entry_t* begin,
+                                      oc_sort_entry_t* end) {
+  if (begin == end)
+    return 1;
+
+  size_t limit = 0;
+  for (oc_sort_entry_t* cur = begin + 1; cur < end; ++cur) {
+    oc_sort_entry_t* sift = cur;
+    oc_sort_entry_t* sift_1 = cur - 1;
+    if (sift->key < sift_1->key) {
+      oc_sort_entry_t tmp = *sift;
+      do {
+        *sift-- = *sift_1;
+      } while (sift != begin && tmp.key < (--sift_1)->key);
+      *sift = tmp;
+      limit += (size_t)(cur - sift);
+    }
+    if (limit > OC_SORT_PDQ_PARTIAL_LIMIT)
+      return 0;
+  }
+  return 1;
+}
+
+// Exchanges `num` misplaced pairs recorded in the offset buffers. When the
+// counts differ a cyclic permutation is cheaper than pairwise swaps.
+static void pdq_swap_offsets(oc_sort_entry_t* first, oc_sort_entry_t* last,
+                             const unsigned char* offsets_l,
+                             const unsigned char* offsets_r, size_t num,
+                             int use_swaps) {
+  if (use_swaps) {
+    for (size_t i = 0; i < num; ++i)
+      swap(first + offsets_l[i], last - offsets_r[i]);
+  } else if (num > 0) {
+    oc_sort_entry_t* l = first + offsets_l[0];
+    oc_sort_entry_t* r = last - offsets_r[0];
+    oc_sort_entry_t tmp = *l;
+    *l = *r;
+    for (size_t i = 1; i < num; ++i) {
+      l = first + offsets_l[i];
+      *r = *l;
+      r = last - offsets_r[i];
+      *l = *r;
+    }
+    *r = tmp;
+  }
+}
+
+// Partitions [begin, end) around the pivot *begin; keys equal to the pivot go
+// right. Returns the final pivot position and sets `already_partitioned` if
+// no element had to be moved.
+static oc_sort_entry_t* pdq_partition_right(oc_sort_entry_t* begin,
+                                            oc_sort_entry_t* end,
+                                            int* already_partitioned) {
+  oc_sort_entry_t pivot = *begin;
+  oc_sort_entry_t* first = begin;
+  oc_sort_entry_t* last = end;
+
+  // The median-of-3 guarantees an element >= pivot, so the first scan is
+  // unguarded. The second is guarded only if nothing was skipped.
+  while ((++first)->key < pivot.key) {
+  }
+  if (first - 1 == begin) {
+    while (first < last && !((--last)->key < pivot.key)) {
+    }
+  } else {
+    while (!((--last)->key < pivot.key)) {
+    }
+  }
+
+  *already_partitioned = first >= last;
+  if (!*already_partitioned) {
+    swap(first, last);
+    ++first;
+
+    unsigned char offsets_l[OC_SORT_PDQ_BLOCK_SIZE];
+    unsigned char offsets_r[OC_SORT_PDQ_BLOCK_SIZE];
+    oc_sort_entry_t* offsets_l_base = first;
+    oc_sort_entry_t* offsets_r_base = last;
+    size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+    while (first < last) {
+      // Fill whichever offset buffer is empty, splitting what is left when
+      // less than two blocks remain.
+      size_t num_unknown = (size_t)(last - first);
+      size_t left_split =
+          num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+      size_t right_split = num_r == 0 ? (num_unknown - left_split) : 0;
+
+      if (left_split > OC_SORT_PDQ_BLOCK_SIZE)
+        left_split = OC_SORT_PDQ_BLOCK_SIZE;
+      if (right_split > OC_SORT_PDQ_BLOCK_SIZE)
+        right_split = OC_SORT_PDQ_BLOCK_SIZE;
+
+      for (size_t i = 0; i < left_split; ++i) {
+        offsets_l[num_l] = (unsigned char)i;
+        num_l += !(first->key < pivot.key);
+        ++first;
+      }
+      for (size_t i = 0; i < right_split;) {
+        offsets_r[num_r] = (unsigned char)++i;
+        num_r += (--last)->key < pivot.key;
+      }
+
+      size_t num = num_l < num_r ? num_l : num_r;
+      pdq_swap_offsets(offsets_l_base, offsets_r_base, offsets_l + start_l,
+                       offsets_r + start_r, num, num_l == num_r);
+      num_l -= num;
+      num_r -= num;
+      start_l += num;
+      start_r += num;
+      if (num_l == 0) {
+        start_l = 0;
+        offsets_l_base = first;
+      }
+      if (num_r == 0) {
+        start_r = 0;
+        offsets_r_base = last;
+      }
+    }
+
+    // Leftover offsets from one side are swapped into the middle.
+    if (num_l) {
+      while (num_l--)
+        swap(offsets_l_base + offsets_l[start_l + num_l], --last);
+      first = last;
+    }
+    if (num_r) {
+      while (num_r--) {
+        swap(offsets_r_base - offsets_r[start_r + num_r], first);
+        ++first;
+      }
+      last = first;
+    }
+  }
+
+  oc_sort_entry_t* pivot_pos = first - 1;
+  *begin = *pivot_pos;
+  *pivot_pos = pivot;
+  return pivot_pos;
+}
+
+// Partitions [begin, end) with keys equal to the pivot *begin going left.
+// Used when the pivot equals the element before the range, in which case the
+// whole left side equals the pivot and needs no further sorting.
+static oc_sort_entry_t* pdq_partition_left(oc_sort_entry_t* begin,
+                                           oc_sort_entry_t* end) {
+  oc_sort_entry_t pivot = *begin;
+  oc_sort_entry_t* first = begin;
+  oc_sort_entry_t* last = end;
+
+  while (pivot.key < (--last)->key) {
+  }
+  if (last + 1 == end) {
+    while (first < last && !(pivot.key < (++first)->key)) {
+    }
+  } else {
+    while (!(pivot.key < (++first)->key)) {
+    }
+  }
+
+  while (first < last) {
+    swap(first, last);
+    while (pivot.key < (--last)->key) {
+    }
+    while (!(pivot.key < (++first)->key)) {
+    }
+  }
+
+  oc_sort_entry_t* pivot_pos = last;
+  *begin = *pivot_pos;
+  *pivot_pos = pivot;
+  return pivot_pos;
+}
+
+// Swaps a few elements of an unbalanced partition to break up patterns.
+static void pdq_break_patterns(oc_sort_entry_t* begin, oc_sort_entry_t* end) {
+  size_t size = (size_t)(end - begin);
+  if (size < OC_SORT_PDQ_SMALL_THRESHOLD)
+    return;
+
+  size_t q = size / 4;
+  swap(begin, begin + q);
+  swap(end - 1, end - q);
+  if (size > OC_SORT_NINTHER_THRESHOLD) {
+    swap(begin + 1, begin + (q + 1));
+    swap(begin + 2, begin + (q + 2));
+    swap(end - 2, end - (q + 1));
+    swap(end - 3, end - (q + 2));
+  }
+}
+
+static void pdq_loop(oc_sort_entry_t* begin, oc_sort_entry_t* end,
+                     unsigned bad_allowed, int leftmost) {
+  for (;;) {
+    size_t size = (size_t)(end - begin);
+    if (size < OC_SORT_PDQ_SMALL_THRESHOLD) {
+      if (leftmost || oc_sortnet_simd_enabled())
+        small_sort(begin, size);
+      else
+        pdq_unguarded_insertion_sort(begin, end);
+      return;
+    }
+
+    // Median-of-3 or ninther, moved to *begin.
+    size_t s2 = size / 2;
+    if (size > OC_SORT_NINTHER_THRESHOLD) {
+      pdq_sort3(begin, begin + s2, end - 1);
+      pdq_sort3(begin + 1, begin + (s2 - 1), end - 2);
+      pdq_sort3(begin + 2, begin + (s2 + 1), end - 3);
+      pdq_sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1));
+      swap(begin, begin + s2);
     } else {
-      temp[k++] = d[j++];
+      pdq_sort3(begin + s2, begin, end - 1);
+    }
+
+    // A pivot equal to the predecessor means the range holds many copies of
+    // it: put them all left and skip them.
+    if (!leftmost && !((begin - 1)->key < begin->key)) {
+      begin = pdq_partition_left(begin, end) + 1;
+      continue;
     }
+
+    int already_partitioned;
+    oc_sort_entry_t* pivot_pos =
+        pdq_partition_right(begin, end, &already_partitioned);
+    size_t l_size = (size_t)(pivot_pos - begin);
+    size_t r_size = (size_t)(end - (pivot_pos + 1));
+
+    if (l_size < size / 8 || r_size < size / 8) {
+      if (--bad_allowed == 0) {
+        heap_sort_range(begin, size);
+        return;
+      }
+      pdq_break_patterns(begin, pivot_pos);
+      pdq_break_patterns(pivot_pos + 1, end);
+    } else if (already_partitioned &&
+               pdq_partial_insertion_sort(begin, pivot_pos) &&
+               pdq_partial_insertion_sort(pivot_pos + 1, end)) {
+      return;
+    }
+
+    // Recurse into the smaller side, loop on the larger one.
+    if (l_size < r_size) {
+      pdq_loop(begin, pivot_pos, bad_allowed, leftmost);
+      begin = pivot_pos + 1;
+      leftmost = 0;
+    } else {
+      pdq_loop(pivot_pos + 1, end, bad_allowed, 0);
+      end = pivot_pos;
+    }
+  }
+}
+
+void oc_sort_pdq(oc_sort_list_t* list) {
+  if (list->n > 1) {
+    unsigned bad_allowed = introsort_depth_limit(list->n) / 2;
+    pdq_loop(list->d, list->d + list->n, bad_allowed, 1);
+  }
+}
+
+// --- Two-way Merge Sort ---
+static void merge_sort_no_alloc(oc_sort_entry_t* d, size_t n);
+
+// Stable merge of the sorted runs a[0..na) and b[0..nb) into out. On equal
+// keys the element from `a` is taken first.
+static void merge_ranges(const oc_sort_entry_t* a, size_t na,
+                         const oc_sort_entry_t* b, size_t nb,
+                         oc_sort_entry_t* out) {
+  size_t i = 0, j = 0, k = 0;
+  while (i < na && j < nb) {
+    // Select instead of branching: the outcome is random on random input.
+    int take_b = b[j].key < a[i].key;
+    const oc_sort_entry_t* next = take_b ? &b[j] : &a[i];
+    out[k++] = *next;
+    j += (size_t)take_b;
+    i += (size_t)!take_b;
   }
-  while (i <= mid)
-    temp[k++] = d[i++];
-  while (j <= high)
-    temp[k++] = d[j++];
-  for (i = low; i <= high; ++i)
-    d[i] = temp[i];
+  while (i < na)
+    out[k++] = a[i++];
+  while (j < nb)
+    out[k++] = b[j++];
 }
 
-static void msort_recursive(oc_sort_entry_t* d, oc_sort_entry_t* temp, int low,
-                            int high) {
-  if (low < high) {
-    int mid = (low + high) / 2;
+// Merges the sorted closed ranges [low, mid] and [mid + 1, high].
+static void merge(oc_sort_entry_t* d, oc_sort_entry_t* temp, size_t low,
+                  size_t mid, size_t high) {
+  merge_ranges(d + low, mid - low + 1, d + mid + 1, high - mid, temp + low);
+  memcpy(d + low, temp + low, (high - low + 1) * sizeof(oc_sort_entry_t));
+}
+
+static void msort_recursive(oc_sort_entry_t* d, oc_sort_entry_t* temp,
+                            size_t low, size_t high) {
+  if (high - low + 1 <= small_sort_cutoff()) {
+    small_sort_stable(d + low, high - low + 1);
+  } else {
+    size_t mid = low + (high - low) / 2;
     msort_recursive(d, temp, low, mid);
     msort_recursive(d, temp, mid + 1, high);
     merge(d, temp, low, mid, high);
@@ -112,38 +553,1893 @@ static void msort_recursive(oc_sort_entry_t* d, oc_sort_entry_t* temp, int low,
 }
 
 void oc_sort_merge(oc_sort_list_t* list) {
+  if (list->n < 2)
+    return;
+
   // Allocate temp array on heap to avoid stack overflow for large N
   oc_sort_entry_t* temp =
-      (oc_sort_entry_t*)malloc((list->n + 1) * sizeof(oc_sort_entry_t));
-  if (!temp)
-    return;  // Allocation failed
+      (oc_sort_entry_t*)malloc(list->n * sizeof(oc_sort_entry_t));
+  if (!temp) {
+    merge_sort_no_alloc(list->d, list->n);  // Allocation failed
+    return;
+  }
+
+  msort_recursive(list->d, temp, 0, list->n - 1);
+  free(temp);
+}
+
+// --- Bottom-up Merge Sort ---
+// Runs are sorted in place with the stable small-range sort (OC_SORTNET_MAX
+// entries with the SIMD network, OC_SORT_MERGE_RUN with insertion sort),
+// then merged with doubling widths. Each pass reads from one buffer and
+// writes the other, so nothing is copied back per merge; only if the pass
+// count is odd does the result need one final copy into the list.
+void oc_sort_merge_bottom_up(oc_sort_list_t* list) {
+  size_t n = list->n;
+  if (n < 2)
+    return;
+
+  size_t run = oc_sortnet_simd_enabled() ? OC_SORTNET_MAX : OC_SORT_MERGE_RUN;
+  for (size_t lo = 0; lo < n; lo += run) {
+    size_t len = n - lo < run ? n - lo : run;
+    small_sort_stable(list->d + lo, len);
+  }
+  if (n <= run)
+    return;
+
+  oc_sort_entry_t* temp =
+      (oc_sort_entry_t*)malloc(n * sizeof(oc_sort_entry_t));
+  if (!temp) {
+    merge_sort_no_alloc(list->d, n);  // Allocation failed
+    return;
+  }
+
+  oc_sort_entry_t* src = list->d;
+  oc_sort_entry_t* dst = temp;
+  for (size_t width = run; width < n; width *= 2) {
+    for (size_t lo = 0; lo < n; lo += 2 * width) {
+      size_t mid = n - lo < width ? n : lo + width;
+      size_t hi = n - mid < width ? n : mid + width;
+      if (mid == hi || src[mid - 1].key <= src[mid].key) {
+        // Lone run, or the two runs are already in order.
+        memcpy(dst + lo, src + lo, (hi - lo) * sizeof(oc_sort_entry_t));
+      } else {
+        merge_ranges(src + lo, mid - lo, src + mid, hi - mid, dst + lo);
+      }
+    }
+    oc_sort_entry_t* swap_buf = src;
+    src = dst;
+    dst = swap_buf;
+  }
+
+  if (src != list->d)
+    memcpy(list->d, src, n * sizeof(oc_sort_entry_t));
+  free(temp);
+}
+
+// --- In-place Stable Merge Sort ---
+// Merge sort whose merges need no n-element buffer. Two adjacent runs are
+// merged through the buffer when the shorter one fits in it. Otherwise the
+// longer run is cut in half, the matching cut point in the other run is
+// found by binary search, the two middle pieces are swapped with a rotation
+// and both halves are merged recursively (the scheme of libstdc++'s
+// __merge_adaptive). Splits keep equal keys in order, so the sort is
+// stable. With a buffer of about sqrt(n) entries nearly all merges at the
+// lower levels go through it; without one the rotations make the sort
+// O(n log^2 n).
+
+// Entries of the buffer kept on the stack for every in-place merge.
+#define OC_SORT_INPLACE_STACK_BUFFER 256
+
+typedef struct {
+  oc_sort_entry_t* d;    // Caller's buffer, or `local`
+  size_t cap;
+  oc_sort_entry_t local[OC_SORT_INPLACE_STACK_BUFFER];
+} inplace_buffer_t;
+
+static void reverse_range(oc_sort_entry_t* d, size_t n) {
+  for (size_t i = 0, j = n; i + 1 < j; ++i, --j)
+    swap(&d[i], &d[j - 1]);
+}
+
+// Swaps the adjacent blocks d[0..na) and d[na..na + nb).
+static void rotate_blocks(oc_sort_entry_t* d, size_t na, size_t nb,
+                          inplace_buffer_t* buf) {
+  if (na == 0 || nb == 0)
+    return;
+  if (na <= buf->cap && na <= nb) {
+    memcpy(buf->d, d, na * sizeof(oc_sort_entry_t));
+    memmove(d, d + na, nb * sizeof(oc_sort_entry_t));
+    memcpy(d + nb, buf->d, na * sizeof(oc_sort_entry_t));
+  } else if (nb <= buf->cap) {
+    memcpy(buf->d, d + na, nb * sizeof(oc_sort_entry_t));
+    memmove(d + nb, d, na * sizeof(oc_sort_entry_t));
+    memcpy(d, buf->d, nb * sizeof(oc_sort_entry_t));
+  } else {
+    reverse_range(d, na);
+    reverse_range(d + na, nb);
+    reverse_range(d, na + nb);
+  }
+}
+
+// First position in d[0..n) whose key is >= key (or > key if `upper`).
+static size_t bound_key(const oc_sort_entry_t* d, size_t n, oc_key_type_t key,
+                        bool upper) {
+  size_t lo = 0;
+  while (n > 0) {
+    size_t half = n / 2;
+    bool right = upper ? d[lo + half].key <= key : d[lo + half].key < key;
+    lo = right ? lo + half + 1 : lo;
+    n = right ? n - half - 1 : half;
+  }
+  return lo;
+}
+
+// Stably merges the sorted runs d[0..na) and d[na..na + nb).
+static void merge_in_place(oc_sort_entry_t* d, size_t na, size_t nb,
+                           inplace_buffer_t* buf) {
+  while (na > 0 && nb > 0 && d[na - 1].key > d[na].key) {
+    if (na <= buf->cap && na <= nb) {
+      // Forward merge with the left run moved out of the way.
+      oc_sort_entry_t* a = buf->d;
+      memcpy(a, d, na * sizeof(oc_sort_entry_t));
+      size_t i = 0, j = na, k = 0, end = na + nb;
+      while (i < na && j < end) {
+        int take_b = d[j].key < a[i].key;
+        const oc_sort_entry_t* next = take_b ? &d[j] : &a[i];
+        d[k++] = *next;
+        j += (size_t)take_b;
+        i += (size_t)!take_b;
+      }
+      memcpy(d + k, a + i, (na - i) * sizeof(oc_sort_entry_t));
+      return;
+    }
+    if (nb <= buf->cap) {
+      // Backward merge with the right run moved out of the way.
+      oc_sort_entry_t* b = buf->d;
+      memcpy(b, d + na, nb * sizeof(oc_sort_entry_t));
+      size_t i = na, j = nb, k = na + nb;
+      while (i > 0 && j > 0) {
+        int take_a = b[j - 1].key < d[i - 1].key;
+        const oc_sort_entry_t* next = take_a ? &d[i - 1] : &b[j - 1];
+        d[--k] = *next;
+        i -= (size_t)take_a;
+        j -= (size_t)!take_a;
+      }
+      memcpy(d, b, j * sizeof(oc_sort_entry_t));
+      return;
+    }
+
+    size_t cut_a, cut_b;
+    if (na >= nb) {
+      cut_a = na / 2;
+      cut_b = bound_key(d + na, nb, d[cut_a].key, false);
+    } else {
+      cut_b = nb / 2;
+      cut_a = bound_key(d, na, d[na + cut_b].key, true);
+    }
+    rotate_blocks(d + cut_a, na - cut_a, cut_b, buf);
+    // Recurse into the smaller half and loop on the larger one, so the
+    // stack stays logarithmic.
+    size_t mid = cut_a + cut_b;
+    if (cut_a + cut_b <= na + nb - mid) {
+      merge_in_place(d, cut_a, cut_b, buf);
+      d += mid;
+      na -= cut_a;
+      nb -= cut_b;
+    } else {
+      merge_in_place(d + mid, na - cut_a, nb - cut_b, buf);
+      na = cut_a;
+      nb = cut_b;
+    }
+  }
+}
+
+static void inplace_msort(oc_sort_entry_t* d, size_t n,
+                          inplace_buffer_t* buf) {
+  if (n <= small_sort_cutoff()) {
+    small_sort_stable(d, n);
+    return;
+  }
+  size_t mid = n / 2;
+  inplace_msort(d, mid, buf);
+  inplace_msort(d + mid, n - mid, buf);
+  merge_in_place(d, mid, n - mid, buf);
+}
+
+// Sorts with only the stack buffer; used when a sort's scratch buffer
+// cannot be allocated.
+static void merge_sort_no_alloc(oc_sort_entry_t* d, size_t n) {
+  inplace_buffer_t buf;
+  buf.d = buf.local;
+  buf.cap = OC_SORT_INPLACE_STACK_BUFFER;
+  inplace_msort(d, n, &buf);
+}
+
+oc_error_code_t oc_sort_merge_in_place(oc_sort_list_t* list,
+                                       size_t buffer_entries) {
+  if (list->n < 2)
+    return OC_SUCCESS;
+  if (buffer_entries <= OC_SORT_INPLACE_STACK_BUFFER) {
+    merge_sort_no_alloc(list->d, list->n);
+    return OC_SUCCESS;
+  }
+
+  inplace_buffer_t buf;
+  buf.cap = buffer_entries < list->n / 2 ? buffer_entries : list->n / 2;
+  buf.d = (oc_sort_entry_t*)malloc(buf.cap * sizeof(oc_sort_entry_t));
+  if (!buf.d)
+    return OC_ERROR_ALLOC;
+  inplace_msort(list->d, list->n, &buf);
+  free(buf.d);
+  return OC_SUCCESS;
+}
+
+// --- Parallel Merge Sort ---
+// The range is cut into one chunk per thread and each chunk is sorted with
+// msort_recursive. Adjacent runs are then merged pairwise, round by round,
+// alternating between `d` and `temp`. Within a round every pair merge is
+// split into equal output slices using co-ranks (merge path), so all threads
+// stay busy even in the final merge of two halves.
+
+typedef struct {
+  oc_sort_entry_t* d;
+  oc_sort_entry_t* temp;
+  size_t low, high;  // Closed range of the chunk
+} msort_task_t;
+
+typedef struct {
+  const oc_sort_entry_t* a;
+  size_t na;
+  const oc_sort_entry_t* b;
+  size_t nb;
+  oc_sort_entry_t* out;  // Output of the whole pair merge
+  size_t k_begin, k_end;  // Output slice handled by this task
+} pmerge_task_t;
+
+// Number of elements taken from `a` among the first k outputs of the stable
+// merge of a[0..na) and b[0..nb).
+static size_t co_rank(size_t k, const oc_sort_entry_t* a, size_t na,
+                      const oc_sort_entry_t* b, size_t nb) {
+  size_t i = k < na ? k : na;
+  size_t j = k - i;
+  size_t i_low = k > nb ? k - nb : 0;
+  size_t j_low = k > na ? k - na : 0;
+  for (;;) {
+    if (i > 0 && j < nb && a[i - 1].key > b[j].key) {
+      size_t delta = (i - i_low + 1) / 2;  // Took too many from `a`
+      j_low = j;
+      i -= delta;
+      j += delta;
+    } else if (j > 0 && i < na && b[j - 1].key >= a[i].key) {
+      size_t delta = (j - j_low + 1) / 2;  // Took too few from `a`
+      i_low = i;
+      i += delta;
+      j -= delta;
+    } else {
+      return i;
+    }
+  }
+}
+
+static void* msort_worker(void* arg) {
+  msort_task_t* t = (msort_task_t*)arg;
+  msort_recursive(t->d, t->temp, t->low, t->high);
+  return NULL;
+}
+
+static void* pmerge_worker(void* arg) {
+  pmerge_task_t* t = (pmerge_task_t*)arg;
+  size_t i0 = co_rank(t->k_begin, t->a, t->na, t->b, t->nb);
+  size_t i1 = co_rank(t->k_end, t->a, t->na, t->b, t->nb);
+  size_t j0 = t->k_begin - i0;
+  size_t j1 = t->k_end - i1;
+  merge_ranges(t->a + i0, i1 - i0, t->b + j0, j1 - j0, t->out + t->k_begin);
+  return NULL;
+}
+
+// Runs `worker` over `count` tasks of `stride` bytes each, one thread per
+// task. Task 0 (and any task whose thread cannot be created) runs on the
+// calling thread.
+static void run_tasks(void* (*worker)(void*), void* tasks, size_t stride,
+                      size_t count) {
+  pthread_t* threads = (pthread_t*)malloc(count * sizeof(pthread_t));
+  unsigned char* started = (unsigned char*)calloc(count, 1);
+  char* base = (char*)tasks;
+
+  for (size_t i = 1; i < count; ++i) {
+    if (threads && started &&
+        pthread_create(&threads[i], NULL, worker, base + i * stride) == 0) {
+      started[i] = 1;
+    } else {
+      worker(base + i * stride);
+    }
+  }
+  worker(base);
+
+  for (size_t i = 1; i < count; ++i) {
+    if (started && started[i])
+      pthread_join(threads[i], NULL);
+  }
+  free(threads);
+  free(started);
+}
+
+static unsigned online_cpus(void) {
+  long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  return cpus > 0 ? (unsigned)cpus : 1;
+}
+
+void oc_sort_merge_parallel(oc_sort_list_t* list, unsigned num_threads) {
+  size_t n = list->n;
+  if (n < 2)
+    return;
+
+  if (num_threads == 0)
+    num_threads = online_cpus();
+  // Do not split below the chunk size where threading stops paying off.
+  size_t max_chunks = n / OC_SORT_PARALLEL_MIN_CHUNK;
+  if (num_threads > max_chunks)
+    num_threads = max_chunks ? (unsigned)max_chunks : 1;
+  if (num_threads == 1) {
+    oc_sort_merge(list);
+    return;
+  }
+
+  size_t runs = num_threads;
+  oc_sort_entry_t* temp = (oc_sort_entry_t*)malloc(n * sizeof(oc_sort_entry_t));
+  size_t* bounds = (size_t*)malloc((runs + 1) * sizeof(size_t));
+  msort_task_t* sort_tasks =
+      (msort_task_t*)malloc(runs * sizeof(msort_task_t));
+  pmerge_task_t* merge_tasks =
+      (pmerge_task_t*)malloc((runs + 1) * sizeof(pmerge_task_t));
+  if (!temp || !bounds || !sort_tasks || !merge_tasks) {
+    free(temp);  // Allocation failed
+    free(bounds);
+    free(sort_tasks);
+    free(merge_tasks);
+    merge_sort_no_alloc(list->d, n);
+    return;
+  }
+
+  // Phase 1: sort one chunk per thread.
+  for (size_t c = 0; c <= runs; ++c)
+    bounds[c] = n / runs * c + n % runs * c / runs;
+  for (size_t c = 0; c < runs; ++c) {
+    sort_tasks[c] = (msort_task_t){list->d, temp, bounds[c], bounds[c + 1] - 1};
+  }
+  run_tasks(msort_worker, sort_tasks, sizeof(msort_task_t), runs);
+
+  // Phase 2: merge adjacent runs until one is left.
+  oc_sort_entry_t* src = list->d;
+  oc_sort_entry_t* dst = temp;
+  while (runs > 1) {
+    size_t pairs = runs / 2;
+    size_t slices = num_threads / pairs;
+    size_t count = 0;
+    for (size_t p = 0; p < pairs; ++p) {
+      size_t lo = bounds[2 * p], mid = bounds[2 * p + 1];
+      size_t hi = bounds[2 * p + 2];
+      for (size_t s = 0; s < slices; ++s) {
+        merge_tasks[count++] = (pmerge_task_t){
+            .a = src + lo,
+            .na = mid - lo,
+            .b = src + mid,
+            .nb = hi - mid,
+            .out = dst + lo,
+            .k_begin = (hi - lo) * s / slices,
+            .k_end = (hi - lo) * (s + 1) / slices};
+      }
+    }
+    if (runs % 2) {
+      // The odd run out is carried over unchanged, merged with the empty
+      // run at its end (a valid pointer, unlike NULL, for the merge's
+      // pointer arithmetic).
+      size_t lo = bounds[runs - 1], hi = bounds[runs];
+      merge_tasks[count++] = (pmerge_task_t){.a = src + lo,
+                                             .na = hi - lo,
+                                             .b = src + hi,
+                                             .nb = 0,
+                                             .out = dst + lo,
+                                             .k_end = hi - lo};
+    }
+    run_tasks(pmerge_worker, merge_tasks, sizeof(pmerge_task_t), count);
+
+    for (size_t r = 0; 2 * r <= runs; ++r)
+      bounds[r] = bounds[2 * r];
+    bounds[(runs + 1) / 2] = n;
+    runs = (runs + 1) / 2;
 
-  msort_recursive(list->d, temp, 1, list->n);
+    oc_sort_entry_t* swap_buf = src;
+    src = dst;
+    dst = swap_buf;
+  }
+
+  if (src != list->d)
+    memcpy(list->d, src, n * sizeof(oc_sort_entry_t));
   free(temp);
+  free(bounds);
+  free(sort_tasks);
+  free(merge_tasks);
+}
+
+// --- Parallel Sample Sort ---
+// Super scalar sample sort. Splitters are picked from an oversampled,
+// sorted random sample and laid out as an implicit binary search tree, so a
+// key finds its bucket with log2(buckets) branch-free steps. Each key equal
+// to a splitter goes to an equality bucket of its own, which needs no
+// sorting; this keeps inputs with heavy duplicates balanced. Every thread
+// classifies a block and counts its buckets, a prefix sum turns the counts
+// into per-thread write positions, and each thread scatters its block into
+// the scratch buffer in one pass. The buckets are then sorted and copied
+// back by threads pulling bucket indices from a shared counter.
+
+// Leaf buckets of the splitter tree at most (a power of two).
+#define OC_SORT_SAMPLE_MAX_BUCKETS 256
+// Sample keys drawn per bucket.
+#define OC_SORT_SAMPLE_OVERSAMPLING 32
+// Fewer buckets are used if they would average fewer entries than this.
+#define OC_SORT_SAMPLE_MIN_BUCKET 4096
+
+typedef struct {
+  oc_key_type_t tree[OC_SORT_SAMPLE_MAX_BUCKETS];    // Nodes 1..buckets - 1
+  oc_key_type_t sorted[OC_SORT_SAMPLE_MAX_BUCKETS];  // Splitters in order
+  size_t num_splitters;  // Distinct splitters; the rest of `sorted` pads
+  size_t num_buckets;    // Leaf buckets (power of two)
+  unsigned levels;       // log2(num_buckets)
+} sample_splitters_t;
+
+typedef struct {
+  const sample_splitters_t* sp;
+  const oc_sort_entry_t* d;
+  oc_sort_entry_t* temp;
+  uint16_t* bucket;  // Bucket of every entry, filled by the classify pass
+  size_t begin, end;
+  size_t* hist;  // Counts per bucket, then write positions for the scatter
+} sample_block_task_t;
+
+typedef struct {
+  oc_sort_entry_t* d;
+  oc_sort_entry_t* temp;
+  const size_t* bounds;  // Bucket b spans temp[bounds[b]..bounds[b + 1])
+  size_t count;          // Buckets, equality buckets included
+  atomic_size_t* next;   // Next bucket to take
+} sample_bucket_task_t;
+
+// Bucket 2b holds keys with b splitters below them; 2b + 1 holds keys equal
+// to the next splitter.
+static inline size_t sample_classify(const sample_splitters_t* sp,
+                                     oc_key_type_t key) {
+  size_t j = 1;
+  for (unsigned l = 0; l < sp->levels; ++l)
+    j = 2 * j + (size_t)(sp->tree[j] < key);
+  size_t b = j - sp->num_buckets;
+  size_t eq = (size_t)(b < sp->num_splitters) & (size_t)(sp->sorted[b] == key);
+  return 2 * b + eq;
+}
+
+static void sample_build_tree(sample_splitters_t* sp, size_t j, size_t lo,
+                              size_t hi) {
+  if (lo >= hi)
+    return;
+  size_t mid = lo + (hi - lo) / 2;
+  sp->tree[j] = sp->sorted[mid];
+  sample_build_tree(sp, 2 * j, lo, mid);
+  sample_build_tree(sp, 2 * j + 1, mid + 1, hi);
+}
+
+// Picks up to num_buckets - 1 distinct splitters from a random sample and
+// shrinks the tree to fit them. Returns 0 if the sample cannot be allocated.
+static int sample_pick_splitters(const oc_sort_entry_t* d, size_t n,
+                                 size_t num_buckets, sample_splitters_t* sp) {
+  size_t count = num_buckets * OC_SORT_SAMPLE_OVERSAMPLING;
+  oc_sort_entry_t* sample =
+      (oc_sort_entry_t*)malloc(count * sizeof(oc_sort_entry_t));
+  if (!sample)
+    return 0;
+
+  uint64_t x = 0x9E3779B97F4A7C15ull ^ n;  // xorshift64, seeded by n
+  for (size_t i = 0; i < count; ++i) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    sample[i] = d[x % n];
+  }
+  oc_sort_list_t list = oc_sort_list_view(sample, count);
+  oc_sort_pdq(&list);
+
+  size_t m = 0;
+  for (size_t i = 1; i < num_buckets; ++i) {
+    oc_key_type_t key = sample[i * OC_SORT_SAMPLE_OVERSAMPLING - 1].key;
+    if (m == 0 || sp->sorted[m - 1] != key)
+      sp->sorted[m++] = key;
+  }
+  free(sample);
+
+  while (num_buckets / 2 > m)
+    num_buckets /= 2;
+  for (size_t i = m; i < OC_SORT_SAMPLE_MAX_BUCKETS; ++i)
+    sp->sorted[i] = sp->sorted[m - 1];
+  sp->num_splitters = m;
+  sp->num_buckets = num_buckets;
+  sp->levels = 0;
+  while (((size_t)1 << sp->levels) < num_buckets)
+    ++sp->levels;
+  sample_build_tree(sp, 1, 0, num_buckets - 1);
+  return 1;
+}
+
+static void* sample_classify_worker(void* arg) {
+  sample_block_task_t* t = (sample_block_task_t*)arg;
+  for (size_t i = t->begin; i < t->end; ++i) {
+    size_t b = sample_classify(t->sp, t->d[i].key);
+    t->bucket[i] = (uint16_t)b;
+    ++t->hist[b];
+  }
+  return NULL;
+}
+
+static void* sample_scatter_worker(void* arg) {
+  sample_block_task_t* t = (sample_block_task_t*)arg;
+  for (size_t i = t->begin; i < t->end; ++i)
+    t->temp[t->hist[t->bucket[i]]++] = t->d[i];
+  return NULL;
+}
+
+static void* sample_bucket_worker(void* arg) {
+  sample_bucket_task_t* t = (sample_bucket_task_t*)arg;
+  for (;;) {
+    size_t b = atomic_fetch_add(t->next, 1);
+    if (b >= t->count)
+      return NULL;
+    size_t lo = t->bounds[b], hi = t->bounds[b + 1];
+    if (b % 2 == 0 && hi - lo > 1) {
+      oc_sort_list_t list = oc_sort_list_view(t->temp + lo, hi - lo);
+      oc_sort_pdq(&list);
+    }
+    if (hi > lo)
+      memcpy(t->d + lo, t->temp + lo, (hi - lo) * sizeof(oc_sort_entry_t));
+  }
+}
+
+void oc_sort_sample_parallel(oc_sort_list_t* list, unsigned num_threads) {
+  size_t n = list->n;
+  if (num_threads == 0)
+    num_threads = online_cpus();
+  size_t max_blocks = n / OC_SORT_PARALLEL_MIN_CHUNK;
+  if (num_threads > max_blocks)
+    num_threads = max_blocks ? (unsigned)max_blocks : 1;
+  if (num_threads == 1) {
+    oc_sort_pdq(list);
+    return;
+  }
+
+  size_t num_buckets = 2;
+  while (num_buckets < OC_SORT_SAMPLE_MAX_BUCKETS &&
+         n / (2 * num_buckets) >= OC_SORT_SAMPLE_MIN_BUCKET) {
+    num_buckets *= 2;
+  }
+
+  size_t threads = num_threads;
+  size_t slots = 2 * OC_SORT_SAMPLE_MAX_BUCKETS;
+  sample_splitters_t* sp =
+      (sample_splitters_t*)malloc(sizeof(sample_splitters_t));
+  oc_sort_entry_t* temp = (oc_sort_entry_t*)malloc(n * sizeof(oc_sort_entry_t));
+  uint16_t* bucket = (uint16_t*)malloc(n * sizeof(uint16_t));
+  size_t* hist = (size_t*)calloc(threads * slots, sizeof(size_t));
+  size_t* bounds = (size_t*)malloc((slots + 1) * sizeof(size_t));
+  sample_block_task_t* blocks =
+      (sample_block_task_t*)malloc(threads * sizeof(sample_block_task_t));
+  sample_bucket_task_t* workers =
+      (sample_bucket_task_t*)malloc(threads * sizeof(sample_bucket_task_t));
+  if (!sp || !temp || !bucket || !hist || !bounds || !blocks || !workers ||
+      !sample_pick_splitters(list->d, n, num_buckets, sp)) {
+    // Out of memory: sort in place on this thread instead.
+    free(sp);
+    free(temp);
+    free(bucket);
+    free(hist);
+    free(bounds);
+    free(blocks);
+    free(workers);
+    oc_sort_pdq(list);
+    return;
+  }
+  size_t count = 2 * sp->num_buckets;
+
+  // Phase 1: classify each block and count its buckets.
+  for (size_t t = 0; t < threads; ++t) {
+    blocks[t] = (sample_block_task_t){.sp = sp,
+                                      .d = list->d,
+                                      .temp = temp,
+                                      .bucket = bucket,
+                                      .begin = n * t / threads,
+                                      .end = n * (t + 1) / threads,
+                                      .hist = hist + t * slots};
+  }
+  run_tasks(sample_classify_worker, blocks, sizeof(sample_block_task_t),
+            threads);
+
+  // Bucket b of block t starts after all smaller buckets, and after bucket
+  // b of the blocks before t.
+  size_t pos = 0;
+  for (size_t b = 0; b < count; ++b) {
+    bounds[b] = pos;
+    for (size_t t = 0; t < threads; ++t) {
+      size_t c = blocks[t].hist[b];
+      blocks[t].hist[b] = pos;
+      pos += c;
+    }
+  }
+  bounds[count] = n;
+
+  // Phase 2: scatter every block into its bucket slots in temp.
+  run_tasks(sample_scatter_worker, blocks, sizeof(sample_block_task_t),
+            threads);
+
+  // Phase 3: sort the buckets and copy them back.
+  atomic_size_t next;
+  atomic_init(&next, 0);
+  for (size_t t = 0; t < threads; ++t) {
+    workers[t] =
+        (sample_bucket_task_t){list->d, temp, bounds, count, &next};
+  }
+  run_tasks(sample_bucket_worker, workers, sizeof(sample_bucket_task_t),
+            threads);
+
+  free(sp);
+  free(temp);
+  free(bucket);
+  free(hist);
+  free(bounds);
+  free(blocks);
+  free(workers);
+}
+
+// --- K-way Merge (Loser Tree) ---
+// A tournament over the heads of k sorted inputs. Internal node t
+// (1 <= t < k) holds the loser of the match played there and tree[0] the
+// overall winner; input i is the implicit leaf k + i. After the winner's
+// input advances only the matches on its leaf-to-root path are replayed:
+// about log2(k) comparisons per entry, against a binary heap's 2 log2(k).
+// Each input is consumed front to back, so reads stay sequential.
+//
+// Nodes hold a 64-bit tag rather than an input index: the head key (sign
+// flipped to order as unsigned) over the input index. Every match is then
+// one integer comparison that the compiler turns into conditional moves,
+// equal keys go to the lower input (keeping the merge stable), and a
+// drained input is simply the largest tag.
+
+typedef struct {
+  const oc_sort_entry_t* cur;  // Next entry of the input
+  const oc_sort_entry_t* end;  // End of what is loaded; cur == end: drained
+} merge_cursor_t;
+
+#define MERGE_TAG_DRAINED UINT64_MAX
+_Static_assert(sizeof(oc_key_type_t) == 4,
+               "merge_tag packs a 32-bit key and input index into 64 bits");
+
+// With dozens of runs interleaved the hardware prefetcher loses track of
+// some streams, so the winner's run is prefetched this many entries ahead.
+#define OC_SORT_MERGE_PREFETCH 32
+#if defined(__GNUC__)
+#define SORT_PREFETCH(p) __builtin_prefetch(p)
+#else
+#define SORT_PREFETCH(p) ((void)0)
+#endif
+
+static inline uint64_t merge_tag(const merge_cursor_t* c, size_t i) {
+  if (c[i].cur == c[i].end)
+    return MERGE_TAG_DRAINED;
+  uint32_t key = (uint32_t)c[i].cur->key ^ 0x80000000u;
+  return (uint64_t)key << 32 | (uint32_t)i;
+}
+
+static inline size_t merge_tag_input(uint64_t tag) {
+  return (size_t)(uint32_t)tag;
+}
+
+// Plays the leaves in one at a time. The first candidate to reach a node
+// waits there; the second plays it, leaves the loser and moves on. Node
+// tags start out drained, so a waiting slot is told apart by `filled`.
+static void loser_tree_build(uint64_t* tree, unsigned char* filled,
+                             const merge_cursor_t* c, size_t k) {
+  memset(filled, 0, k);
+  tree[0] = MERGE_TAG_DRAINED;
+  for (size_t i = 0; i < k; ++i) {
+    uint64_t s = merge_tag(c, i);
+    size_t t = (i + k) / 2;
+    for (; t > 0; t /= 2) {
+      if (!filled[t]) {
+        filled[t] = 1;
+        tree[t] = s;
+        break;
+      }
+      uint64_t other = tree[t];
+      tree[t] = other > s ? other : s;
+      s = other > s ? s : other;
+    }
+    if (t == 0)
+      tree[0] = s;
+  }
+}
+
+// Replays the matches of input w after it advanced.
+static inline void loser_tree_replay(uint64_t* tree, const merge_cursor_t* c,
+                                     size_t k, size_t w) {
+  uint64_t s = merge_tag(c, w);
+  for (size_t t = (w + k) / 2; t > 0; t /= 2) {
+    uint64_t other = tree[t];
+    tree[t] = other > s ? other : s;
+    s = other > s ? s : other;
+  }
+  tree[0] = s;
+}
+
+oc_error_code_t oc_sort_merge_k(const oc_sort_list_t* runs, size_t k,
+                                oc_sort_list_t* out) {
+  size_t total = 0;
+  for (size_t i = 0; i < k; ++i)
+    total += runs[i].n;
+  if (total > out->n || k > UINT32_MAX)
+    return OC_ERROR_INVALID_ARG;
+  out->n = total;
+
+  if (k == 1) {
+    if (total > 0)
+      memcpy(out->d, runs[0].d, total * sizeof(oc_sort_entry_t));
+    return OC_SUCCESS;
+  }
+  if (k == 2) {
+    merge_ranges(runs[0].d, runs[0].n, runs[1].d, runs[1].n, out->d);
+    return OC_SUCCESS;
+  }
+  if (k == 0)
+    return OC_SUCCESS;
+
+  merge_cursor_t* c = (merge_cursor_t*)malloc(k * sizeof(merge_cursor_t));
+  uint64_t* tree = (uint64_t*)malloc(k * sizeof(uint64_t));
+  unsigned char* filled = (unsigned char*)malloc(k);
+  if (!c || !tree || !filled) {
+    free(c);
+    free(tree);
+    free(filled);
+    return OC_ERROR_ALLOC;
+  }
+
+  for (size_t i = 0; i < k; ++i) {
+    c[i].cur = runs[i].d;
+    c[i].end = runs[i].d + runs[i].n;
+  }
+  loser_tree_build(tree, filled, c, k);
+  for (size_t o = 0; o < total; ++o) {
+    size_t w = merge_tag_input(tree[0]);
+    out->d[o] = *c[w].cur++;
+    SORT_PREFETCH(c[w].cur + OC_SORT_MERGE_PREFETCH);
+    loser_tree_replay(tree, c, k, w);
+  }
+
+  free(c);
+  free(tree);
+  free(filled);
+  return OC_SUCCESS;
+}
+
+oc_error_code_t oc_sort_merge_k_stream(oc_sort_source_t* sources, size_t k,
+                                       oc_sort_sink_t* sink,
+                                       oc_sort_entry_t* buf,
+                                       size_t buf_entries) {
+  if (k == 0)
+    return OC_SUCCESS;
+  if ((buf && buf_entries < k + 1) || k > UINT32_MAX)
+    return OC_ERROR_INVALID_ARG;
+
+  oc_sort_entry_t* owned = NULL;
+  if (!buf) {
+    buf_entries = (k + 1) * OC_SORT_STREAM_BUFFER;
+    buf = owned = (oc_sort_entry_t*)malloc(buf_entries * sizeof(*buf));
+  }
+  merge_cursor_t* c = (merge_cursor_t*)malloc(k * sizeof(merge_cursor_t));
+  uint64_t* tree = (uint64_t*)malloc(k * sizeof(uint64_t));
+  unsigned char* filled = (unsigned char*)malloc(k);
+  if (!buf || !c || !tree || !filled) {
+    free(owned);
+    free(c);
+    free(tree);
+    free(filled);
+    return OC_ERROR_ALLOC;
+  }
+
+  // One slice of the buffer per source, plus one for the output.
+  size_t slice = buf_entries / (k + 1);
+  oc_error_code_t err = OC_SUCCESS;
+  for (size_t i = 0; i < k && err == OC_SUCCESS; ++i) {
+    oc_sort_entry_t* s = buf + i * slice;
+    size_t got = 0;
+    err = sources[i].read(sources[i].ctx, s, slice, &got);
+    c[i].cur = s;
+    c[i].end = s + got;
+  }
+
+  oc_sort_entry_t* out = buf + k * slice;
+  size_t out_n = 0;
+  if (err == OC_SUCCESS)
+    loser_tree_build(tree, filled, c, k);
+  while (err == OC_SUCCESS && tree[0] != MERGE_TAG_DRAINED) {
+    size_t w = merge_tag_input(tree[0]);
+
+    out[out_n++] = *c[w].cur++;
+    if (out_n == slice) {
+      err = sink->write(sink->ctx, out, out_n);
+      out_n = 0;
+    }
+    if (c[w].cur == c[w].end && err == OC_SUCCESS) {
+      // Refill in place; a source that returns nothing stays drained.
+      oc_sort_entry_t* s = buf + w * slice;
+      size_t got = 0;
+      err = sources[w].read(sources[w].ctx, s, slice, &got);
+      c[w].cur = s;
+      c[w].end = s + got;
+    }
+    loser_tree_replay(tree, c, k, w);
+  }
+  if (err == OC_SUCCESS && out_n > 0)
+    err = sink->write(sink->ctx, out, out_n);
+
+  free(owned);
+  free(c);
+  free(tree);
+  free(filled);
+  return err;
 }
 
 // --- Heap Sort ---
-static void heap_adjust(oc_sort_list_t* list, int s, int m) {
-  oc_sort_entry_t rc = list->d[s];
-  for (int j = 2 * s; j <= m; j *= 2) {
-    if (j < m && list->d[j].key < list->d[j + 1].key)
+// Sifts d[s] down within the max-heap d[0]...d[m] (0-based, children of i
+// are 2i + 1 and 2i + 2).
+static void heap_adjust(oc_sort_entry_t* d, size_t s, size_t m) {
+  oc_sort_entry_t rc = d[s];
+  for (size_t j = 2 * s + 1; j <= m; j = 2 * j + 1) {
+    if (j < m && d[j].key < d[j + 1].key)
       ++j;
-    if (rc.key >= list->d[j].key)
+    if (rc.key >= d[j].key)
       break;
-    list->d[s] = list->d[j];
+    d[s] = d[j];
     s = j;
   }
-  list->d[s] = rc;
+  d[s] = rc;
 }
 
-void oc_sort_heap(oc_sort_list_t* list) {
+static void heap_sort_range(oc_sort_entry_t* d, size_t n) {
+  if (n < 2)
+    return;
+
   // Build heap
-  for (int i = list->n / 2; i > 0; --i) {
-    heap_adjust(list, i, list->n);
+  for (size_t i = n / 2; i-- > 0;) {
+    heap_adjust(d, i, n - 1);
   }
   // Sort
-  for (int i = list->n; i > 1; --i) {
-    swap(&list->d[1], &list->d[i]);
-    heap_adjust(list, 1, i - 1);
+  for (size_t i = n - 1; i > 0; --i) {
+    swap(&d[0], &d[i]);
+    heap_adjust(d, 0, i - 1);
+  }
+}
+
+void oc_sort_heap(oc_sort_list_t* list) { heap_sort_range(list->d, list->n); }
+
+// --- D-ary Heap Sort ---
+// A max-heap with OC_SORT_HEAP_ARITY children per node (0-based, children
+// of i are D*i + 1 ... D*i + D). The heap starts up to three entries into
+// the array so that its entry 1 sits on a 32-byte boundary: every sibling
+// group then fills one aligned half line, and picking the largest child
+// touches a single cache line. The tree is also half as deep as a binary
+// heap. While a node's children are compared, the block of its
+// grandchildren (the next level's candidates) is prefetched. The sortdown
+// uses Floyd's bottom-up sift: the hole left by the root is moved down
+// along the largest children to a leaf without comparing against the
+// displaced last entry, which is then sifted up from there; it rarely
+// climbs more than a level, saving a comparison per level.
+#define OC_SORT_HEAP_ARITY 4
+// Entries per cache line, for the grandchild prefetch.
+#define OC_SORT_HEAP_LINE (64 / sizeof(oc_sort_entry_t))
+// Bytes in a sibling group, the alignment the heap's entry 1 is shifted to.
+#define OC_SORT_HEAP_GROUP (OC_SORT_HEAP_ARITY * sizeof(oc_sort_entry_t))
+
+// Index of the largest of d[first .. first + count).
+static inline size_t dary_max_child(const oc_sort_entry_t* d, size_t first,
+                                    size_t count) {
+  size_t best = first;
+  if (count == OC_SORT_HEAP_ARITY) {
+    for (size_t c = 1; c < OC_SORT_HEAP_ARITY; ++c)
+      best = d[first + c].key > d[best].key ? first + c : best;
+  } else {
+    for (size_t c = 1; c < count; ++c)
+      best = d[first + c].key > d[best].key ? first + c : best;
+  }
+  return best;
+}
+
+// Prefetches the grandchild block of the children d[first ...]. The block
+// is two lines long but only group-aligned, so it can straddle three; one
+// fetch per line start plus one for its last entry covers them all. Only
+// full blocks are fetched, which keeps the count fixed; the last partial
+// block sits next to the heap's end and is usually cached anyway.
+static inline void dary_prefetch_grandchildren(const oc_sort_entry_t* d,
+                                               size_t first, size_t n) {
+  const size_t block = OC_SORT_HEAP_ARITY * OC_SORT_HEAP_ARITY;
+  size_t g = OC_SORT_HEAP_ARITY * first + 1;
+  if (g + block <= n) {
+    for (size_t k = 0; k < block; k += OC_SORT_HEAP_LINE)
+      SORT_PREFETCH(d + g + k);
+    SORT_PREFETCH(d + g + block - 1);
+  }
+}
+
+// Sifts d[i] down within the heap d[0..n).
+static void dary_sift_down(oc_sort_entry_t* d, size_t i, size_t n) {
+  oc_sort_entry_t x = d[i];
+  for (size_t first; (first = OC_SORT_HEAP_ARITY * i + 1) < n;) {
+    size_t count = n - first < OC_SORT_HEAP_ARITY ? n - first
+                                                  : OC_SORT_HEAP_ARITY;
+    size_t c = dary_max_child(d, first, count);
+    if (d[c].key <= x.key)
+      break;
+    d[i] = d[c];
+    i = c;
+  }
+  d[i] = x;
+}
+
+// Heap sorts d[0..n), n >= 2.
+static void dary_heap_sort(oc_sort_entry_t* d, size_t n) {
+  // Build the heap bottom-up from the last parent.
+  for (size_t i = (n - 2) / OC_SORT_HEAP_ARITY + 1; i-- > 0;)
+    dary_sift_down(d, i, n);
+
+  for (size_t end = n - 1; end > 0; --end) {
+    oc_sort_entry_t x = d[end];
+    d[end] = d[0];
+    // Move the hole at the root down to a leaf of the heap d[0..end).
+    size_t i = 0;
+    for (size_t first; (first = OC_SORT_HEAP_ARITY * i + 1) < end;) {
+      dary_prefetch_grandchildren(d, first, end);
+      size_t count = end - first < OC_SORT_HEAP_ARITY ? end - first
+                                                      : OC_SORT_HEAP_ARITY;
+      size_t c = dary_max_child(d, first, count);
+      d[i] = d[c];
+      i = c;
+    }
+    // Sift the displaced last entry up from the leaf.
+    while (i > 0) {
+      size_t parent = (i - 1) / OC_SORT_HEAP_ARITY;
+      if (d[parent].key >= x.key)
+        break;
+      d[i] = d[parent];
+      i = parent;
+    }
+    d[i] = x;
+  }
+}
+
+void oc_sort_heap_dary(oc_sort_list_t* list) {
+  oc_sort_entry_t* d = list->d;
+  size_t n = list->n;
+  if (n < 2)
+    return;
+
+  // Skip the entries before the first group-aligned entry 1. An array that
+  // is not even entry-aligned cannot be shifted into line and is sorted
+  // as is.
+  size_t skip = 0;
+  uintptr_t addr = (uintptr_t)(d + 1);
+  if (addr % sizeof(oc_sort_entry_t) == 0) {
+    skip = (OC_SORT_HEAP_GROUP - addr % OC_SORT_HEAP_GROUP) %
+           OC_SORT_HEAP_GROUP / sizeof(oc_sort_entry_t);
+  }
+  if (n < skip + 2) {
+    insertion_sort_range(d, n);
+    return;
+  }
+  dary_heap_sort(d + skip, n - skip);
+
+  // Insert the skipped entries into the sorted rest, last one first.
+  for (size_t k = skip; k-- > 0;) {
+    oc_sort_entry_t x = d[k];
+    size_t lo = k + 1, hi = n;
+    while (lo < hi) {
+      size_t mid = lo + (hi - lo) / 2;
+      if (d[mid].key < x.key)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    memmove(d + k, d + k + 1, (lo - k - 1) * sizeof(oc_sort_entry_t));
+    d[lo - 1] = x;
+  }
+}
+
+// --- Selection, Partial Sort and Top-k ---
+// Introselect: quick sort partitioning that only follows the side holding the
+// wanted rank, so the expected cost is O(n). On large ranges the pivot comes
+// from Floyd-Rivest sampling: the rank is first selected within a small
+// window around its expected position, which makes the pivot land close to
+// the target and the range shrink to about n^(2/3) per step. Past the depth
+// limit the range is heap sorted, bounding the worst case to O(n log n).
+
+// Ranges above this size pick the pivot with Floyd-Rivest sampling.
+#define OC_SORT_FLOYD_RIVEST_THRESHOLD 600
+
+static void select_loop(oc_sort_entry_t* d, size_t low, size_t high,
+                        size_t nth, unsigned depth_limit) {
+  while (high > low) {
+    size_t n = high - low + 1;
+    if (n <= small_sort_cutoff()) {
+      small_sort(d + low, n);
+      return;
+    }
+    if (depth_limit == 0) {
+      heap_sort_range(d + low, n);
+      return;
+    }
+    --depth_limit;
+
+    if (n > OC_SORT_FLOYD_RIVEST_THRESHOLD) {
+      // Window of about n^(2/3) around the expected position of nth.
+      double nn = (double)n;
+      double i = (double)(nth - low + 1);
+      double z = log(nn);
+      double s = 0.5 * exp(2.0 * z / 3.0);
+      double sd = 0.5 * sqrt(z * s * (nn - s) / nn);
+      if (i < nn / 2)
+        sd = -sd;
+      double lo = (double)nth - i * s / nn + sd;
+      double hi = (double)nth + (nn - i) * s / nn + sd;
+      size_t new_low = lo > (double)low ? (size_t)lo : low;
+      size_t new_high = hi < (double)high ? (size_t)hi : high;
+      select_loop(d, new_low, new_high, nth, depth_limit);
+      swap(&d[low], &d[nth]);
+    } else {
+      choose_pivot(d, low, high);
+    }
+
+    size_t pivot_loc = partition(d, low, high);
+    if (pivot_loc == nth)
+      return;
+    if (nth < pivot_loc)
+      high = pivot_loc - 1;
+    else
+      low = pivot_loc + 1;
+  }
+}
+
+oc_error_code_t oc_select_nth(oc_sort_list_t* list, size_t nth) {
+  if (nth >= list->n)
+    return OC_ERROR_OUT_OF_BOUNDS;
+  select_loop(list->d, 0, list->n - 1, nth, introsort_depth_limit(list->n));
+  return OC_SUCCESS;
+}
+
+void oc_sort_partial(oc_sort_list_t* list, size_t k) {
+  if (k >= list->n) {
+    oc_sort_quick(list);
+    return;
+  }
+  if (k == 0)
+    return;
+
+  // Select the k smallest into d[0..k - 1], then sort only those.
+  select_loop(list->d, 0, list->n - 1, k - 1, introsort_depth_limit(list->n));
+  if (k > 2)
+    introsort_loop(list->d, 0, k - 2, introsort_depth_limit(k - 1));
+}
+
+// Mirror of heap_adjust() for a min-heap.
+static void heap_adjust_min(oc_sort_entry_t* d, size_t s, size_t m) {
+  oc_sort_entry_t rc = d[s];
+  for (size_t j = 2 * s + 1; j <= m; j = 2 * j + 1) {
+    if (j < m && d[j + 1].key < d[j].key)
+      ++j;
+    if (rc.key <= d[j].key)
+      break;
+    d[s] = d[j];
+    s = j;
   }
+  d[s] = rc;
+}
+
+// The root is the worst kept entry: the largest key when keeping the
+// smallest (a max-heap), the smallest when keeping the largest.
+static void topk_adjust(oc_topk_t* topk, size_t s, size_t m) {
+  if (topk->largest)
+    heap_adjust_min(topk->d, s, m);
+  else
+    heap_adjust(topk->d, s, m);
+}
+
+static void topk_heapify(oc_topk_t* topk) {
+  for (size_t i = topk->n / 2; i-- > 0;)
+    topk_adjust(topk, i, topk->n - 1);
+}
+
+void oc_topk_push(oc_topk_t* topk, oc_sort_entry_t e) {
+  if (topk->n < topk->capacity) {
+    // Filling up: append, and heapify once when the buffer becomes full.
+    topk->d[topk->n++] = e;
+    if (topk->n == topk->capacity)
+      topk_heapify(topk);
+    return;
+  }
+  if (topk->capacity == 0)
+    return;
+
+  oc_sort_entry_t* root = &topk->d[0];
+  if (topk->largest ? e.key > root->key : e.key < root->key) {
+    *root = e;
+    topk_adjust(topk, 0, topk->capacity - 1);
+  }
+}
+
+oc_sort_list_t oc_topk_finish(oc_topk_t* topk) {
+  size_t n = topk->n;
+  if (n < topk->capacity)
+    topk_heapify(topk);
+  // Popping the worst entry to the back leaves the best one first.
+  for (size_t i = n; i-- > 1;) {
+    swap(&topk->d[0], &topk->d[i]);
+    topk_adjust(topk, 0, i - 1);
+  }
+  topk->n = 0;
+  return oc_sort_list_view(topk->d, n);
+}
+
+// --- LSD Radix Sort ---
+// Keys are bucketed one byte per pass, least significant byte first. The key
+// is viewed as unsigned with the sign bit flipped so negative keys order
+// before positive ones.
+#define OC_SORT_RADIX_BITS 8
+#define OC_SORT_RADIX_BUCKETS (1u << OC_SORT_RADIX_BITS)
+#define OC_SORT_RADIX_PASSES sizeof(oc_key_type_t)
+
+static inline unsigned radix_key(oc_key_type_t key) {
+  return (unsigned)key ^ ~(UINT_MAX >> 1);
+}
+
+static inline unsigned radix_digit(unsigned k, unsigned shift) {
+  return (k >> shift) & (OC_SORT_RADIX_BUCKETS - 1);
+}
+
+// Returns false, leaving d unchanged, if the scratch buffer cannot be
+// allocated.
+static bool radix_sort_range(oc_sort_entry_t* d, size_t n) {
+  if (n < 2)
+    return true;
+
+  oc_sort_entry_t* temp =
+      (oc_sort_entry_t*)malloc(n * sizeof(oc_sort_entry_t));
+  if (!temp)
+    return false;
+
+  // Build the histograms for every byte in a single read of the input.
+  size_t counts[OC_SORT_RADIX_PASSES][OC_SORT_RADIX_BUCKETS];
+  memset(counts, 0, sizeof(counts));
+  for (size_t i = 0; i < n; ++i) {
+    unsigned k = radix_key(d[i].key);
+    for (size_t p = 0; p < OC_SORT_RADIX_PASSES; ++p) {
+      ++counts[p][radix_digit(k, (unsigned)(p * OC_SORT_RADIX_BITS))];
+    }
+  }
+
+  oc_sort_entry_t* src = d;
+  oc_sort_entry_t* dst = temp;
+  for (size_t p = 0; p < OC_SORT_RADIX_PASSES; ++p) {
+    unsigned shift = (unsigned)(p * OC_SORT_RADIX_BITS);
+    size_t* count = counts[p];
+
+    // Every key shares this byte: the pass would be an identity copy.
+    if (count[radix_digit(radix_key(src[0].key), shift)] == n)
+      continue;
+
+    // Exclusive prefix sum turns counts into bucket start offsets.
+    size_t offset = 0;
+    for (unsigned b = 0; b < OC_SORT_RADIX_BUCKETS; ++b) {
+      size_t c = count[b];
+      count[b] = offset;
+      offset += c;
+    }
+
+    // Forward scatter keeps equal keys in input order (stable).
+    for (size_t i = 0; i < n; ++i) {
+      unsigned b = radix_digit(radix_key(src[i].key), shift);
+      dst[count[b]++] = src[i];
+    }
+
+    oc_sort_entry_t* swap_buf = src;
+    src = dst;
+    dst = swap_buf;
+  }
+
+  // After an odd number of scatters the result lives in the scratch buffer.
+  if (src != d)
+    memcpy(d, src, n * sizeof(oc_sort_entry_t));
+  free(temp);
+  return true;
+}
+
+void oc_sort_radix(oc_sort_list_t* list) {
+  if (!radix_sort_range(list->d, list->n))
+    merge_sort_no_alloc(list->d, list->n);  // Allocation failed
+}
+
+// --- Counting Sort ---
+// One histogram over the key range [min, max], then a stable scatter into a
+// scratch buffer. Linear in n + range, so only worth it for small ranges;
+// wider ranges are handed to the radix sort.
+#define OC_SORT_COUNTING_MAX_RANGE ((size_t)1 << 16)
+
+// Key range of a non-empty list as a count of distinct possible values.
+static inline size_t key_range(oc_key_type_t min, oc_key_type_t max) {
+  return (size_t)((unsigned)max - (unsigned)min) + 1;
+}
+
+// Returns false, leaving d unchanged, if the buffers cannot be allocated.
+static bool counting_sort_range(oc_sort_entry_t* d, size_t n,
+                                oc_key_type_t min, oc_key_type_t max) {
+  size_t range = key_range(min, max);
+  size_t* count = (size_t*)calloc(range, sizeof(size_t));
+  oc_sort_entry_t* temp =
+      (oc_sort_entry_t*)malloc(n * sizeof(oc_sort_entry_t));
+  if (!count || !temp) {
+    free(count);
+    free(temp);
+    return false;
+  }
+
+  for (size_t i = 0; i < n; ++i)
+    ++count[(unsigned)d[i].key - (unsigned)min];
+  size_t offset = 0;
+  for (size_t k = 0; k < range; ++k) {
+    size_t c = count[k];
+    count[k] = offset;
+    offset += c;
+  }
+  for (size_t i = 0; i < n; ++i)
+    temp[count[(unsigned)d[i].key - (unsigned)min]++] = d[i];
+  memcpy(d, temp, n * sizeof(oc_sort_entry_t));
+
+  free(count);
+  free(temp);
+  return true;
+}
+
+void oc_sort_counting(oc_sort_list_t* list) {
+  size_t n = list->n;
+  if (n < 2)
+    return;
+  oc_key_type_t min = list->d[0].key, max = list->d[0].key;
+  for (size_t i = 1; i < n; ++i) {
+    oc_key_type_t k = list->d[i].key;
+    min = k < min ? k : min;
+    max = k > max ? k : max;
+  }
+  if (min == max)
+    return;
+  bool sorted = key_range(min, max) > OC_SORT_COUNTING_MAX_RANGE
+                    ? radix_sort_range(list->d, n)
+                    : counting_sort_range(list->d, n, min, max);
+  if (!sorted)
+    merge_sort_no_alloc(list->d, n);  // Allocation failed
+}
+
+// --- Automatic Dispatch ---
+// One sequential pass measures the key range and how many neighbours are out
+// of order. The thresholds below are untuned starting points; compare the
+// paths with benchmark_sorting before relying on them for a workload.
+
+// Lists up to this size are insertion sorted.
+#define OC_SORT_AUTO_INSERTION_MAX 32
+// From this size on random keys are radix sorted rather than pdqsorted.
+#define OC_SORT_AUTO_RADIX_MIN 256
+// Lists with at most n / 16 descents count as nearly sorted; pdqsort's
+// partial insertion sorts finish those faster than the radix passes.
+#define OC_SORT_AUTO_NEARLY_SORTED_DIV 16
+// The parallel sample sort is used from this size on, given enough CPUs.
+#define OC_SORT_AUTO_PARALLEL_MIN ((size_t)1 << 20)
+#define OC_SORT_AUTO_PARALLEL_MIN_CPUS 4
+
+static const char* const SORT_PATH_NAMES[] = {
+    "none", "reverse", "insertion", "counting", "pdq", "radix", "parallel"};
+
+const char* oc_sort_path_name(oc_sort_path_t path) {
+  return (unsigned)path < sizeof(SORT_PATH_NAMES) / sizeof(SORT_PATH_NAMES[0])
+             ? SORT_PATH_NAMES[path]
+             : "unknown";
+}
+
+oc_sort_plan_t oc_sort_auto_plan(const oc_sort_list_t* list) {
+  oc_sort_plan_t plan = {OC_SORT_PATH_NONE, list->n, 0, 0, 0, 0};
+  size_t n = list->n;
+  if (n < 2)
+    return plan;
+
+  const oc_sort_entry_t* d = list->d;
+  oc_key_type_t min = d[0].key, max = d[0].key;
+  size_t descents = 0, ascents = 0;
+  for (size_t i = 1; i < n; ++i) {
+    oc_key_type_t k = d[i].key, prev = d[i - 1].key;
+    min = k < min ? k : min;
+    max = k > max ? k : max;
+    descents += k < prev;
+    ascents += k > prev;
+  }
+  plan.min_key = min;
+  plan.max_key = max;
+  plan.descents = descents;
+  plan.ascents = ascents;
+
+  size_t range = key_range(min, max);
+  if (descents == 0)
+    plan.path = OC_SORT_PATH_NONE;
+  else if (ascents == 0)
+    plan.path = OC_SORT_PATH_REVERSE;
+  else if (n <= OC_SORT_AUTO_INSERTION_MAX)
+    plan.path = OC_SORT_PATH_INSERTION;
+  else if (range <= n && range <= OC_SORT_COUNTING_MAX_RANGE)
+    plan.path = OC_SORT_PATH_COUNTING;
+  else if (descents <= n / OC_SORT_AUTO_NEARLY_SORTED_DIV)
+    plan.path = OC_SORT_PATH_PDQ;
+  else if (n >= OC_SORT_AUTO_PARALLEL_MIN &&
+           online_cpus() >= OC_SORT_AUTO_PARALLEL_MIN_CPUS)
+    plan.path = OC_SORT_PATH_PARALLEL;
+  else if (n >= OC_SORT_AUTO_RADIX_MIN)
+    plan.path = OC_SORT_PATH_RADIX;
+  else
+    plan.path = OC_SORT_PATH_PDQ;
+  return plan;
+}
+
+oc_sort_plan_t oc_sort_auto(oc_sort_list_t* list) {
+  oc_sort_plan_t plan = oc_sort_auto_plan(list);
+  oc_sort_entry_t* d = list->d;
+  size_t n = list->n;
+  switch (plan.path) {
+    case OC_SORT_PATH_NONE:
+      break;
+    case OC_SORT_PATH_REVERSE:
+      for (size_t i = 0, j = n - 1; i < j; ++i, --j)
+        swap(&d[i], &d[j]);
+      break;
+    case OC_SORT_PATH_INSERTION:
+      insertion_sort_range(d, n);
+      break;
+    case OC_SORT_PATH_COUNTING:
+      if (counting_sort_range(d, n, plan.min_key, plan.max_key))
+        break;
+      plan.path = OC_SORT_PATH_PDQ;  // Out of memory: sort in place
+      oc_sort_pdq(list);
+      break;
+    case OC_SORT_PATH_PDQ:
+      oc_sort_pdq(list);
+      break;
+    case OC_SORT_PATH_RADIX:
+      if (radix_sort_range(d, n))
+        break;
+      plan.path = OC_SORT_PATH_PDQ;
+      oc_sort_pdq(list);
+      break;
+    case OC_SORT_PATH_PARALLEL:
+      oc_sort_sample_parallel(list, 0);
+      break;
+  }
+  return plan;
+}
+
+// --- Index Sort and Key/Value (Structure-of-Arrays) Sort ---
+// Only the key and a 32-bit position travel through the sort, as an
+// oc_sort_entry_t sorted with the stable radix sort. Payloads of any width
+// are then moved once: gathered into a scratch array, whose loads are
+// independent and overlap, and copied back. Without memory for the scratch
+// array they are moved in place along the cycles of the permutation, which
+// needs one element and one bit per position but walks a chain of
+// dependent random loads.
+
+// Returns (keys[i], i) pairs in stable key order, or NULL if out of memory.
+_Static_assert(sizeof(oc_data_type_t) == 4,
+               "positions are stored in the 32-bit payload, up to INT_MAX");
+static oc_sort_entry_t* sort_key_positions(const oc_key_type_t* keys,
+                                           size_t n) {
+  oc_sort_entry_t* e =
+      (oc_sort_entry_t*)malloc((n ? n : 1) * sizeof(oc_sort_entry_t));
+  if (!e)
+    return NULL;
+  for (size_t i = 0; i < n; ++i) {
+    e[i].key = keys[i];
+    e[i].data = (oc_data_type_t)i;
+  }
+  if (!radix_sort_range(e, n)) {
+    free(e);
+    return NULL;
+  }
+  return e;
+}
+
+// Source position of slot i: order[i].data if `order` is given, else perm[i].
+static inline size_t permutation_source(const oc_sort_entry_t* order,
+                                        const size_t* perm, size_t i) {
+  return order ? (size_t)order[i].data : perm[i];
+}
+
+// Sets dst[i] to src[source(i)] for every i.
+static void permute_gather(char* restrict dst, const char* restrict src,
+                           size_t n, size_t size, const oc_sort_entry_t* order,
+                           const size_t* perm) {
+  switch (size) {
+    case sizeof(uint32_t):
+      for (size_t i = 0; i < n; ++i) {
+        memcpy(dst + i * sizeof(uint32_t),
+               src + permutation_source(order, perm, i) * sizeof(uint32_t),
+               sizeof(uint32_t));
+      }
+      break;
+    case sizeof(uint64_t):
+      for (size_t i = 0; i < n; ++i) {
+        memcpy(dst + i * sizeof(uint64_t),
+               src + permutation_source(order, perm, i) * sizeof(uint64_t),
+               sizeof(uint64_t));
+      }
+      break;
+    default:
+      for (size_t i = 0; i < n; ++i)
+        memcpy(dst + i * size, src + permutation_source(order, perm, i) * size,
+               size);
+      break;
+  }
+}
+
+// Sets v[i] to the old v[source(i)] for every i, in place. `done` must hold
+// n zeroed bits and `saved` one element.
+static void permute_cycles(char* v, size_t n, size_t size,
+                           const oc_sort_entry_t* order, const size_t* perm,
+                           unsigned char* done, char* saved) {
+  for (size_t start = 0; start < n; ++start) {
+    if (done[start / CHAR_BIT] & (1u << (start % CHAR_BIT)))
+      continue;
+    size_t j = start;
+    size_t k = permutation_source(order, perm, j);
+    if (k != start) {
+      memcpy(saved, v + start * size, size);
+      while (k != start) {
+        memcpy(v + j * size, v + k * size, size);
+        done[j / CHAR_BIT] |= (unsigned char)(1u << (j % CHAR_BIT));
+        j = k;
+        k = permutation_source(order, perm, j);
+      }
+      memcpy(v + j * size, saved, size);
+    }
+    done[j / CHAR_BIT] |= (unsigned char)(1u << (j % CHAR_BIT));
+  }
+}
+
+oc_error_code_t oc_sort_index(const oc_key_type_t* keys, size_t n,
+                              size_t* perm) {
+  if (n > 0 && (!keys || !perm))
+    return OC_ERROR_INVALID_ARG;
+  if (n > (size_t)INT_MAX)
+    return OC_ERROR_INVALID_ARG;  // Positions must fit oc_data_type_t
+
+  oc_sort_entry_t* e = sort_key_positions(keys, n);
+  if (!e)
+    return OC_ERROR_ALLOC;
+  for (size_t i = 0; i < n; ++i)
+    perm[i] = (size_t)e[i].data;
+  free(e);
+  return OC_SUCCESS;
+}
+
+// Rearranges v by the permutation. `saved` and `done` are the in-place
+// fallback's scratch, used only if the gather buffer cannot be allocated.
+static void permute_values(char* v, size_t n, size_t size,
+                           const oc_sort_entry_t* order, const size_t* perm,
+                           unsigned char* done, char* saved) {
+  char* temp = (size_t)-1 / size >= n ? (char*)malloc(n * size) : NULL;
+  if (temp) {
+    permute_gather(temp, v, n, size, order, perm);
+    memcpy(v, temp, n * size);
+    free(temp);
+  } else {
+    permute_cycles(v, n, size, order, perm, done, saved);
+  }
+}
+
+oc_error_code_t oc_sort_apply_permutation(void* values, size_t n,
+                                          size_t value_size,
+                                          const size_t* perm) {
+  if (n > 0 && (!values || !perm || value_size == 0))
+    return OC_ERROR_INVALID_ARG;
+  if (n < 2)
+    return OC_SUCCESS;
+
+  unsigned char* done = (unsigned char*)calloc(n / CHAR_BIT + 1, 1);
+  char* saved = (char*)malloc(value_size);
+  if (!done || !saved) {
+    free(done);
+    free(saved);
+    return OC_ERROR_ALLOC;
+  }
+  permute_values((char*)values, n, value_size, NULL, perm, done, saved);
+  free(done);
+  free(saved);
+  return OC_SUCCESS;
+}
+
+oc_error_code_t oc_sort_kv(oc_key_type_t* keys, void* values, size_t n,
+                           size_t value_size) {
+  if (n > 0 && (!keys || (value_size > 0 && !values)))
+    return OC_ERROR_INVALID_ARG;
+  if (n > (size_t)INT_MAX)
+    return OC_ERROR_INVALID_ARG;
+  if (n < 2)
+    return OC_SUCCESS;
+
+  // Allocate the fallback's scratch up front so a failure leaves both
+  // arrays untouched.
+  unsigned char* done = (unsigned char*)calloc(n / CHAR_BIT + 1, 1);
+  char* saved = (char*)malloc(value_size ? value_size : 1);
+  oc_sort_entry_t* e = done && saved ? sort_key_positions(keys, n) : NULL;
+  if (!e) {
+    free(done);
+    free(saved);
+    return OC_ERROR_ALLOC;
+  }
+
+  for (size_t i = 0; i < n; ++i)
+    keys[i] = e[i].key;
+  if (value_size > 0)
+    permute_values((char*)values, n, value_size, e, NULL, done, saved);
+
+  free(e);
+  free(done);
+  free(saved);
+  return OC_SUCCESS;
+}
+
+// --- Adaptive Natural Merge Sort (Timsort / Powersort) ---
+// The list is scanned left to right for natural runs. Strictly descending
+// runs are reversed (strictness keeps the sort stable), and runs shorter than
+// minrun are extended with binary insertion. Runs are pushed on a stack and
+// merged following the powersort policy, which keeps merges balanced. Merges
+// trim the parts already in place and switch to galloping (exponential
+// search) when one side keeps winning, so ordered input costs about O(n).
+
+#define OC_SORT_TIM_MIN_MERGE 64
+#define OC_SORT_TIM_MIN_GALLOP 7
+#define OC_SORT_TIM_MAX_RUNS 85  // > log2(SIZE_MAX) + 1; powersort bound
+
+typedef struct {
+  size_t base;
+  size_t len;
+  unsigned power;  // Power of the boundary with the next run on the stack
+} tim_run_t;
+
+typedef struct {
+  oc_sort_entry_t* d;
+  oc_sort_entry_t* tmp;  // Holds the smaller run during a merge
+  size_t n;
+  unsigned min_gallop;
+  tim_run_t runs[OC_SORT_TIM_MAX_RUNS];
+  size_t num_runs;
+} tim_state_t;
+
+// Returns the first k in [0, n] such that a[k].key is not below `key` (or,
+// with `inclusive`, is above `key`). The search starts at `hint` and widens
+// exponentially before bisecting, so it is cheap when the answer is near.
+static size_t gallop(oc_key_type_t key, const oc_sort_entry_t* a, size_t n,
+                     size_t hint, int inclusive) {
+#define TIM_BEFORE(k) (inclusive ? a[k].key <= key : a[k].key < key)
+  size_t lo, hi;
+  if (TIM_BEFORE(hint)) {
+    // Answer is right of hint.
+    size_t last = hint, ofs = 1;
+    while (hint + ofs < n && TIM_BEFORE(hint + ofs)) {
+      last = hint + ofs;
+      ofs = (ofs << 1) + 1;
+    }
+    lo = last + 1;
+    hi = hint + ofs < n ? hint + ofs : n;
+  } else {
+    // Answer is at or left of hint.
+    size_t last = hint, ofs = 1;
+    while (ofs <= hint && !TIM_BEFORE(hint - ofs)) {
+      last = hint - ofs;
+      ofs = (ofs << 1) + 1;
+    }
+    lo = ofs <= hint ? hint - ofs + 1 : 0;
+    hi = last;
+  }
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    if (TIM_BEFORE(mid))
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+#undef TIM_BEFORE
+}
+
+// Sorts d[lo, hi) given that d[lo, start) is already sorted.
+static void binary_insertion_sort(oc_sort_entry_t* d, size_t lo, size_t hi,
+                                  size_t start) {
+  for (size_t i = start; i < hi; ++i) {
+    oc_sort_entry_t pivot = d[i];
+    size_t left = lo, right = i;
+    while (left < right) {  // Upper bound keeps equal keys in order
+      size_t mid = left + (right - left) / 2;
+      if (pivot.key < d[mid].key)
+        right = mid;
+      else
+        left = mid + 1;
+    }
+    for (size_t j = i; j > left; --j)  // Short shifts; cheaper than memmove
+      d[j] = d[j - 1];
+    d[left] = pivot;
+  }
+}
+
+// Length of the run starting at d[lo], made ascending in place.
+static size_t count_run(oc_sort_entry_t* d, size_t lo, size_t hi) {
+  size_t end = lo + 1;
+  if (end == hi)
+    return 1;
+  if (d[end].key < d[lo].key) {
+    while (end + 1 < hi && d[end + 1].key < d[end].key)
+      ++end;
+    ++end;
+    for (size_t i = lo, j = end - 1; i < j; ++i, --j)
+      swap(&d[i], &d[j]);
+  } else {
+    while (end + 1 < hi && d[end + 1].key >= d[end].key)
+      ++end;
+    ++end;
+  }
+  return end - lo;
+}
+
+// Timsort's minimum run length: in [32, 64] and close to, but no larger
+// than, a power of two fraction of n.
+static size_t tim_minrun(size_t n) {
+  size_t r = 0;
+  while (n >= OC_SORT_TIM_MIN_MERGE) {
+    r |= n & 1;
+    n >>= 1;
+  }
+  return n + r;
+}
+
+// Powersort: depth of the boundary between run1 = [s1, s1 + n1) and the
+// following run of length n2 in the virtual balanced merge tree over n.
+static unsigned node_power(size_t s1, size_t n1, size_t n2, size_t n) {
+  unsigned result = 0;
+  size_t a = 2 * s1 + n1;
+  size_t b = a + n1 + n2;
+  for (;;) {
+    ++result;
+    if (a >= n) {
+      a -= n;
+      b -= n;
+    } else if (b >= n) {
+      break;
+    }
+    a <<= 1;
+    b <<= 1;
+  }
+  return result;
+}
+
+// Merges A = d[base_a, +len_a) into the adjacent B when len_a <= len_b.
+static void tim_merge_lo(tim_state_t* ts, size_t base_a, size_t len_a,
+                         size_t base_b, size_t len_b) {
+  oc_sort_entry_t* d = ts->d;
+  oc_sort_entry_t* tmp = ts->tmp;
+  memcpy(tmp, d + base_a, len_a * sizeof(oc_sort_entry_t));
+
+  size_t i = 0, j = base_b, k = base_a;
+  size_t end_b = base_b + len_b;
+  unsigned min_gallop = ts->min_gallop;
+
+  while (i < len_a && j < end_b) {
+    // One element at a time until a side wins min_gallop times in a row.
+    // Selects instead of branches, as in merge_ranges; `streak` counts the
+    // consecutive wins of the side that won last.
+    size_t streak = 0, prev = 2;
+    do {
+      size_t take_b = d[j].key < tmp[i].key;
+      const oc_sort_entry_t* next = take_b ? &d[j] : &tmp[i];
+      d[k++] = *next;
+      j += take_b;
+      i += 1 - take_b;
+      streak = (streak & (0 - (size_t)(take_b == prev))) + 1;
+      prev = take_b;
+    } while (i < len_a && j < end_b && streak < min_gallop);
+    if (i == len_a || j == end_b)
+      break;
+
+    size_t count_a, count_b;
+
+    // Galloping: move whole blocks while they stay long.
+    do {
+      count_a = gallop(d[j].key, tmp + i, len_a - i, 0, 1);
+      memcpy(d + k, tmp + i, count_a * sizeof(oc_sort_entry_t));
+      k += count_a;
+      i += count_a;
+      if (i == len_a)
+        break;
+      d[k++] = d[j++];
+      if (j == end_b)
+        break;
+
+      count_b = gallop(tmp[i].key, d + j, end_b - j, 0, 0);
+      memmove(d + k, d + j, count_b * sizeof(oc_sort_entry_t));
+      k += count_b;
+      j += count_b;
+      if (j == end_b)
+        break;
+      d[k++] = tmp[i++];
+      if (i == len_a)
+        break;
+
+      if (min_gallop > 1)
+        --min_gallop;
+    } while (count_a >= OC_SORT_TIM_MIN_GALLOP ||
+             count_b >= OC_SORT_TIM_MIN_GALLOP);
+    ++min_gallop;  // Penalize leaving galloping mode
+  }
+
+  // Whatever is left of B is already in place.
+  memcpy(d + k, tmp + i, (len_a - i) * sizeof(oc_sort_entry_t));
+  ts->min_gallop = min_gallop;
+}
+
+// Merges A = d[base_a, +len_a) with the adjacent B when len_b < len_a,
+// filling from the right.
+static void tim_merge_hi(tim_state_t* ts, size_t base_a, size_t len_a,
+                         size_t base_b, size_t len_b) {
+  oc_sort_entry_t* d = ts->d;
+  oc_sort_entry_t* tmp = ts->tmp;
+  memcpy(tmp, d + base_b, len_b * sizeof(oc_sort_entry_t));
+
+  // i and j are exclusive ends of what remains of A and B; k of the output.
+  size_t i = base_a + len_a, j = len_b, k = base_b + len_b;
+  unsigned min_gallop = ts->min_gallop;
+
+  while (i > base_a && j > 0) {
+    size_t streak = 0, prev = 2;
+    do {
+      size_t take_a = tmp[j - 1].key < d[i - 1].key;
+      const oc_sort_entry_t* next = take_a ? &d[i - 1] : &tmp[j - 1];
+      d[--k] = *next;
+      i -= take_a;
+      j -= 1 - take_a;
+      streak = (streak & (0 - (size_t)(take_a == prev))) + 1;
+      prev = take_a;
+    } while (i > base_a && j > 0 && streak < min_gallop);
+    if (i == base_a || j == 0)
+      break;
+
+    size_t count_a, count_b;
+
+    do {
+      // Elements of A above the current B go last.
+      size_t rem_a = i - base_a;
+      count_a = rem_a - gallop(tmp[j - 1].key, d + base_a, rem_a, rem_a - 1, 1);
+      k -= count_a;
+      i -= count_a;
+      memmove(d + k, d + i, count_a * sizeof(oc_sort_entry_t));
+      if (i == base_a)
+        break;
+      d[--k] = tmp[--j];
+      if (j == 0)
+        break;
+
+      // Elements of B not below the current A go last.
+      count_b = j - gallop(d[i - 1].key, tmp, j, j - 1, 0);
+      k -= count_b;
+      j -= count_b;
+      memcpy(d + k, tmp + j, count_b * sizeof(oc_sort_entry_t));
+      if (j == 0)
+        break;
+      d[--k] = d[--i];
+      if (i == base_a)
+        break;
+
+      if (min_gallop > 1)
+        --min_gallop;
+    } while (count_a >= OC_SORT_TIM_MIN_GALLOP ||
+             count_b >= OC_SORT_TIM_MIN_GALLOP);
+    ++min_gallop;
+  }
+
+  // Whatever is left of A is already in place.
+  memcpy(d + base_a, tmp, j * sizeof(oc_sort_entry_t));
+  ts->min_gallop = min_gallop;
+}
+
+// Merges stack entries idx and idx + 1.
+static void tim_merge_at(tim_state_t* ts, size_t idx) {
+  tim_run_t* a = &ts->runs[idx];
+  tim_run_t* b = &ts->runs[idx + 1];
+  size_t base_a = a->base, len_a = a->len;
+  size_t base_b = b->base, len_b = b->len;
+
+  a->len = len_a + len_b;
+  a->power = b->power;
+  for (size_t r = idx + 1; r + 1 < ts->num_runs; ++r)
+    ts->runs[r] = ts->runs[r + 1];
+  --ts->num_runs;
+
+  // Leading elements of A and trailing elements of B are already in place.
+  size_t skip = gallop(ts->d[base_b].key, ts->d + base_a, len_a, 0, 1);
+  base_a += skip;
+  len_a -= skip;
+  if (len_a == 0)
+    return;
+  len_b = gallop(ts->d[base_a + len_a - 1].key, ts->d + base_b, len_b,
+                 len_b - 1, 0);
+  if (len_b == 0)
+    return;
+
+  if (len_a <= len_b)
+    tim_merge_lo(ts, base_a, len_a, base_b, len_b);
+  else
+    tim_merge_hi(ts, base_a, len_a, base_b, len_b);
+}
+
+void oc_sort_tim(oc_sort_list_t* list) {
+  size_t n = list->n;
+  if (n < 2)
+    return;
+
+  size_t minrun = tim_minrun(n);
+  size_t run = count_run(list->d, 0, n);
+  if (run == n)
+    return;  // Already sorted (or strictly descending, now reversed)
+
+  oc_sort_entry_t* tmp =
+      (oc_sort_entry_t*)malloc((n / 2 + 1) * sizeof(oc_sort_entry_t));
+  if (!tmp) {
+    merge_sort_no_alloc(list->d, n);  // Allocation failed
+    return;
+  }
+
+  tim_state_t state;
+  tim_state_t* ts = &state;
+  ts->d = list->d;
+  ts->tmp = tmp;
+  ts->n = n;
+  ts->min_gallop = OC_SORT_TIM_MIN_GALLOP;
+  ts->num_runs = 0;
+
+  size_t lo = 0;
+  while (lo < n) {
+    if (lo > 0)
+      run = count_run(list->d, lo, n);
+    if (run < minrun) {
+      size_t forced = n - lo < minrun ? n - lo : minrun;
+      binary_insertion_sort(list->d, lo, lo + forced, lo + run);
+      run = forced;
+    }
+
+    if (ts->num_runs > 0) {
+      tim_run_t* top = &ts->runs[ts->num_runs - 1];
+      unsigned power = node_power(top->base, top->len, run, n);
+      while (ts->num_runs > 1 && ts->runs[ts->num_runs - 2].power > power)
+        tim_merge_at(ts, ts->num_runs - 2);
+      ts->runs[ts->num_runs - 1].power = power;
+    }
+    ts->runs[ts->num_runs++] = (tim_run_t){lo, run, 0};
+    lo += run;
+  }
+
+  while (ts->num_runs > 1)
+    tim_merge_at(ts, ts->num_runs - 2);
+
+  free(tmp);
 }
@@ -0,0 +1,399 @@
+// -*- mode: C; indent-tabs-mode: nil; c-basic-offset: 2; tab-width: 2; -*-
+
+#include "omnic/sortnet.h"
+
+#include <limits.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+
+// The AVX2 kernels are compiled per function with a target attribute and
+// picked at run time, so the rest of the library keeps the baseline ISA.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define OC_SORTNET_HAVE_AVX2 1
+#include <immintrin.h>
+#define SORTNET_AVX2 __attribute__((target("avx2")))
+#else
+#define OC_SORTNET_HAVE_AVX2 0
+#endif
+
+// Networks sort a power-of-two block; the tail is padded with the largest
+// value, which sorts last and is dropped on the way out.
+static size_t pow2_at_least(size_t n, size_t min) {
+  size_t p = min;
+  while (p < n)
+    p <<= 1;
+  return p;
+}
+
+// --- Scalar Networks ---
+// Bitonic sort of x[0..p) in the "flip" formulation: the first step of each
+// merge compares i with its mirror i ^ (k - 1), so every compare-exchange is
+// ascending and compiles to conditional moves.
+static void scalar_bitonic_i32(int* x, size_t p) {
+  for (size_t k = 2; k <= p; k <<= 1) {
+    for (size_t j = k - 1; j > 0; j = (j == k - 1) ? k >> 2 : j >> 1) {
+      for (size_t i = 0; i < p; ++i) {
+        size_t l = i ^ j;
+        if (l > i) {
+          int a = x[i], b = x[l];
+          x[i] = a < b ? a : b;
+          x[l] = a < b ? b : a;
+        }
+      }
+    }
+  }
+}
+
+static void scalar_bitonic_i64(int64_t* x, size_t p) {
+  for (size_t k = 2; k <= p; k <<= 1) {
+    for (size_t j = k - 1; j > 0; j = (j == k - 1) ? k >> 2 : j >> 1) {
+      for (size_t i = 0; i < p; ++i) {
+        size_t l = i ^ j;
+        if (l > i) {
+          int64_t a = x[i], b = x[l];
+          x[i] = a < b ? a : b;
+          x[l] = a < b ? b : a;
+        }
+      }
+    }
+  }
+}
+
+// Merges a[0..na) and b[0..nb) into out.
+static void scalar_merge_i32(const int* a, size_t na, const int* b, size_t nb,
+                             int* out) {
+  size_t i = 0, j = 0;
+  while (i < na && j < nb) {
+    int take_b = b[j] < a[i];
+    *out++ = take_b ? b[j] : a[i];
+    j += (size_t)take_b;
+    i += (size_t)!take_b;
+  }
+  while (i < na)
+    *out++ = a[i++];
+  while (j < nb)
+    *out++ = b[j++];
+}
+
+#if OC_SORTNET_HAVE_AVX2
+// --- AVX2 Networks: 8 x int32 ---
+// A register is sorted with a bitonic network built from lane shuffles; a
+// block of registers is then merged pairwise, comparing each register with
+// the lane-reversed mirror register and finishing with half-cleaners across
+// and inside registers. `lo`/`hi` of each step are recombined with a blend
+// that keeps the minimum in the lower lane of every compared pair.
+
+SORTNET_AVX2 static inline __m256i i32_reverse(__m256i v) {
+  return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2,
+                                                          1, 0));
+}
+
+// Sorts a bitonic register (in-register half-cleaners, distances 4, 2, 1).
+SORTNET_AVX2 static inline __m256i i32_cleanup(__m256i v) {
+  __m256i t = _mm256_permute2x128_si256(v, v, 1);
+  v = _mm256_blend_epi32(_mm256_min_epi32(v, t), _mm256_max_epi32(v, t), 0xF0);
+  t = _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+  v = _mm256_blend_epi32(_mm256_min_epi32(v, t), _mm256_max_epi32(v, t), 0xCC);
+  t = _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1));
+  v = _mm256_blend_epi32(_mm256_min_epi32(v, t), _mm256_max_epi32(v, t), 0xAA);
+  return v;
+}
+
+SORTNET_AVX2 static inline __m256i i32_sort8(__m256i v) {
+  __m256i t = _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1));
+  v = _mm256_blend_epi32(_mm256_min_epi32(v, t), _mm256_max_epi32(v, t), 0xAA);
+  t = _mm256_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3));
+  v = _mm256_blend_epi32(_mm256_min_epi32(v, t), _mm256_max_epi32(v, t), 0xCC);
+  t = _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1));
+  v = _mm256_blend_epi32(_mm256_min_epi32(v, t), _mm256_max_epi32(v, t), 0xAA);
+  t = i32_reverse(v);
+  v = _mm256_blend_epi32(_mm256_min_epi32(v, t), _mm256_max_epi32(v, t), 0xF0);
+  t = _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+  v = _mm256_blend_epi32(_mm256_min_epi32(v, t), _mm256_max_epi32(v, t), 0xCC);
+  t = _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1));
+  v = _mm256_blend_epi32(_mm256_min_epi32(v, t), _mm256_max_epi32(v, t), 0xAA);
+  return v;
+}
+
+// Merges two sorted registers: *a receives the 8 smallest keys, *b the 8
+// largest, both sorted.
+SORTNET_AVX2 static inline void i32_merge8(__m256i* a, __m256i* b) {
+  __m256i r = i32_reverse(*b);
+  __m256i lo = _mm256_min_epi32(*a, r);
+  __m256i hi = _mm256_max_epi32(*a, r);
+  *a = i32_cleanup(lo);
+  *b = i32_cleanup(hi);
+}
+
+// Sorts x[0..8 * regs), regs a power of two.
+SORTNET_AVX2 static void avx2_bitonic_i32(int* x, size_t regs) {
+  __m256i r[OC_SORTNET_MAX / 8];
+  for (size_t i = 0; i < regs; ++i)
+    r[i] = i32_sort8(_mm256_loadu_si256((const __m256i*)(x + 8 * i)));
+
+  for (size_t w = 1; w < regs; w <<= 1) {
+    for (size_t base = 0; base < regs; base += 2 * w) {
+      __m256i* blk = r + base;
+      for (size_t i = 0; i < w; ++i) {
+        __m256i a = blk[i];
+        __m256i b = i32_reverse(blk[2 * w - 1 - i]);
+        blk[i] = _mm256_min_epi32(a, b);
+        blk[2 * w - 1 - i] = i32_reverse(_mm256_max_epi32(a, b));
+      }
+      for (size_t d = w / 2; d > 0; d >>= 1) {
+        for (size_t i = 0; i < 2 * w; ++i) {
+          if ((i & d) == 0) {
+            __m256i a = blk[i], b = blk[i + d];
+            blk[i] = _mm256_min_epi32(a, b);
+            blk[i + d] = _mm256_max_epi32(a, b);
+          }
+        }
+      }
+      for (size_t i = 0; i < 2 * w; ++i)
+        blk[i] = i32_cleanup(blk[i]);
+    }
+  }
+
+  for (size_t i = 0; i < regs; ++i)
+    _mm256_storeu_si256((__m256i*)(x + 8 * i), r[i]);
+}
+
+// Register-at-a-time merge: each step loads the next 8 keys from whichever
+// input has the smaller head and merges them with the 8 held back from the
+// previous step, emitting the lower half. Once either input has fewer than
+// 8 keys left, the held register and both tails are merged in scalar code.
+SORTNET_AVX2 static void avx2_merge_i32(const int* a, size_t na, const int* b,
+                                        size_t nb, int* out) {
+  __m256i lo = _mm256_loadu_si256((const __m256i*)a);
+  __m256i hi = _mm256_loadu_si256((const __m256i*)b);
+  size_t i = 8, j = 8;
+  i32_merge8(&lo, &hi);
+  _mm256_storeu_si256((__m256i*)out, lo);
+  out += 8;
+
+  while (i + 8 <= na && j + 8 <= nb) {
+    if (a[i] <= b[j]) {
+      lo = _mm256_loadu_si256((const __m256i*)(a + i));
+      i += 8;
+    } else {
+      lo = _mm256_loadu_si256((const __m256i*)(b + j));
+      j += 8;
+    }
+    i32_merge8(&lo, &hi);
+    _mm256_storeu_si256((__m256i*)out, lo);
+    out += 8;
+  }
+
+  // Three-way tail: the held keys and what remains of a and b.
+  int held[8];
+  size_t h = 0;
+  _mm256_storeu_si256((__m256i*)held, hi);
+  while (h < 8 && i < na && j < nb) {
+    if (held[h] <= a[i] && held[h] <= b[j])
+      *out++ = held[h++];
+    else if (a[i] <= b[j])
+      *out++ = a[i++];
+    else
+      *out++ = b[j++];
+  }
+  if (h < 8) {
+    // One of a or b is exhausted.
+    if (i < na)
+      scalar_merge_i32(held + h, 8 - h, a + i, na - i, out);
+    else
+      scalar_merge_i32(held + h, 8 - h, b + j, nb - j, out);
+  } else {
+    scalar_merge_i32(a + i, na - i, b + j, nb - j, out);
+  }
+}
+
+// --- AVX2 Networks: 4 x int64 ---
+// Same network shape on 4 lanes. AVX2 has no 64-bit min/max, so both are
+// derived from one signed compare.
+
+SORTNET_AVX2 static inline void i64_minmax(__m256i a, __m256i b, __m256i* lo,
+                                           __m256i* hi) {
+  __m256i gt = _mm256_cmpgt_epi64(a, b);
+  *lo = _mm256_blendv_epi8(a, b, gt);
+  *hi = _mm256_blendv_epi8(b, a, gt);
+}
+
+SORTNET_AVX2 static inline __m256i i64_reverse(__m256i v) {
+  return _mm256_permute4x64_epi64(v, _MM_SHUFFLE(0, 1, 2, 3));
+}
+
+SORTNET_AVX2 static inline __m256i i64_cleanup(__m256i v) {
+  __m256i lo, hi;
+  i64_minmax(v, _mm256_permute4x64_epi64(v, _MM_SHUFFLE(1, 0, 3, 2)), &lo,
+             &hi);
+  v = _mm256_blend_epi32(lo, hi, 0xF0);
+  i64_minmax(v, _mm256_permute4x64_epi64(v, _MM_SHUFFLE(2, 3, 0, 1)), &lo,
+             &hi);
+  return _mm256_blend_epi32(lo, hi, 0xCC);
+}
+
+SORTNET_AVX2 static inline __m256i i64_sort4(__m256i v) {
+  __m256i lo, hi;
+  i64_minmax(v, _mm256_permute4x64_epi64(v, _MM_SHUFFLE(2, 3, 0, 1)), &lo,
+             &hi);
+  v = _mm256_blend_epi32(lo, hi, 0xCC);
+  i64_minmax(v, i64_reverse(v), &lo, &hi);
+  v = _mm256_blend_epi32(lo, hi, 0xF0);
+  i64_minmax(v, _mm256_permute4x64_epi64(v, _MM_SHUFFLE(2, 3, 0, 1)), &lo,
+             &hi);
+  return _mm256_blend_epi32(lo, hi, 0xCC);
+}
+
+// Sorts x[0..4 * regs), regs a power of two.
+SORTNET_AVX2 static void avx2_bitonic_i64(int64_t* x, size_t regs) {
+  __m256i r[OC_SORTNET_MAX / 4];
+  for (size_t i = 0; i < regs; ++i)
+    r[i] = i64_sort4(_mm256_loadu_si256((const __m256i*)(x + 4 * i)));
+
+  for (size_t w = 1; w < regs; w <<= 1) {
+    for (size_t base = 0; base < regs; base += 2 * w) {
+      __m256i* blk = r + base;
+      for (size_t i = 0; i < w; ++i) {
+        __m256i lo, hi;
+        i64_minmax(blk[i], i64_reverse(blk[2 * w - 1 - i]), &lo, &hi);
+        blk[i] = lo;
+        blk[2 * w - 1 - i] = i64_reverse(hi);
+      }
+      for (size_t d = w / 2; d > 0; d >>= 1) {
+        for (size_t i = 0; i < 2 * w; ++i) {
+          if ((i & d) == 0)
+            i64_minmax(blk[i], blk[i + d], &blk[i], &blk[i + d]);
+        }
+      }
+      for (size_t i = 0; i < 2 * w; ++i)
+        blk[i] = i64_cleanup(blk[i]);
+    }
+  }
+
+  for (size_t i = 0; i < regs; ++i)
+    _mm256_storeu_si256((__m256i*)(x + 4 * i), r[i]);
+}
+#endif  // OC_SORTNET_HAVE_AVX2
+
+// --- Dispatch ---
+// Parallel sorts reach the kernels from worker threads, so the flags are
+// atomic and the CPU is probed exactly once.
+static atomic_bool g_simd_disabled = false;
+#if OC_SORTNET_HAVE_AVX2
+static pthread_once_t g_cpu_once = PTHREAD_ONCE_INIT;
+static bool g_cpu_avx2 = false;  // Written once under g_cpu_once
+
+static void probe_cpu(void) {
+  __builtin_cpu_init();
+  g_cpu_avx2 = __builtin_cpu_supports("avx2") != 0;
+}
+#endif
+
+bool oc_sortnet_simd_enabled(void) {
+#if OC_SORTNET_HAVE_AVX2
+  pthread_once(&g_cpu_once, probe_cpu);
+  return g_cpu_avx2 &&
+         !atomic_load_explicit(&g_simd_disabled, memory_order_relaxed);
+#else
+  return false;
+#endif
+}
+
+void oc_sortnet_set_simd(bool enabled) {
+  atomic_store_explicit(&g_simd_disabled, !enabled, memory_order_relaxed);
+}
+
+// Sorts x[0..n) of 64-bit composite keys, n <= OC_SORTNET_MAX.
+static void sortnet_i64(int64_t* x, size_t n) {
+  int64_t buf[OC_SORTNET_MAX];
+  size_t p = pow2_at_least(n, 4);
+  memcpy(buf, x, n * sizeof(int64_t));
+  for (size_t i = n; i < p; ++i)
+    buf[i] = INT64_MAX;
+#if OC_SORTNET_HAVE_AVX2
+  if (oc_sortnet_simd_enabled())
+    avx2_bitonic_i64(buf, p / 4);
+  else
+#endif
+    scalar_bitonic_i64(buf, p);
+  memcpy(x, buf, n * sizeof(int64_t));
+}
+
+// The entry's key in the high half, so signed order on the composite is
+// order by key, then by the unsigned low half.
+_Static_assert(sizeof(oc_key_type_t) == 4 && sizeof(oc_data_type_t) == 4,
+               "entry_composite packs a 32-bit key and payload into 64 bits");
+static inline int64_t entry_composite(oc_key_type_t key, uint32_t low) {
+  return (int64_t)(((uint64_t)(int64_t)key << 32) | low);
+}
+
+// --- Public Kernels ---
+oc_error_code_t oc_sortnet_int(int* d, size_t n) {
+  if (n > OC_SORTNET_MAX)
+    return OC_ERROR_INVALID_ARG;
+  if (n < 2)
+    return OC_SUCCESS;
+
+  int buf[OC_SORTNET_MAX];
+  size_t p = pow2_at_least(n, 8);
+  memcpy(buf, d, n * sizeof(int));
+  for (size_t i = n; i < p; ++i)
+    buf[i] = INT_MAX;
+#if OC_SORTNET_HAVE_AVX2
+  if (oc_sortnet_simd_enabled())
+    avx2_bitonic_i32(buf, p / 8);
+  else
+#endif
+    scalar_bitonic_i32(buf, p);
+  memcpy(d, buf, n * sizeof(int));
+  return OC_SUCCESS;
+}
+
+void oc_sortnet_merge_int(const int* a, size_t na, const int* b, size_t nb,
+                          int* out) {
+#if OC_SORTNET_HAVE_AVX2
+  if (na >= 8 && nb >= 8 && oc_sortnet_simd_enabled()) {
+    avx2_merge_i32(a, na, b, nb, out);
+    return;
+  }
+#endif
+  scalar_merge_i32(a, na, b, nb, out);
+}
+
+oc_error_code_t oc_sortnet_entries(oc_sort_entry_t* d, size_t n) {
+  if (n > OC_SORTNET_MAX)
+    return OC_ERROR_INVALID_ARG;
+  if (n < 2)
+    return OC_SUCCESS;
+
+  // Flipping the sign bit makes the data compare as signed in the low half.
+  int64_t x[OC_SORTNET_MAX];
+  for (size_t i = 0; i < n; ++i)
+    x[i] = entry_composite(d[i].key, (uint32_t)d[i].data ^ 0x80000000u);
+  sortnet_i64(x, n);
+  for (size_t i = 0; i < n; ++i) {
+    d[i].key = (oc_key_type_t)(x[i] >> 32);
+    d[i].data = (oc_data_type_t)((uint32_t)x[i] ^ 0x80000000u);
+  }
+  return OC_SUCCESS;
+}
+
+oc_error_code_t oc_sortnet_entries_stable(oc_sort_entry_t* d, size_t n) {
+  if (n > OC_SORTNET_MAX)
+    return OC_ERROR_INVALID_ARG;
+  if (n < 2)
+    return OC_SUCCESS;
+
+  // Tie-break on the input position, then gather the entries in that order.
+  int64_t x[OC_SORTNET_MAX];
+  oc_sort_entry_t copy[OC_SORTNET_MAX];
+  for (size_t i = 0; i < n; ++i)
+    x[i] = entry_composite(d[i].key, (uint32_t)i);
+  memcpy(copy, d, n * sizeof(oc_sort_entry_t));
+  sortnet_i64(x, n);
+  for (size_t i = 0; i < n; ++i)
+    d[i] = copy[(uint32_t)x[i]];
+  return OC_SUCCESS;
+}
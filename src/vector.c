@@ -1,9 +1,11 @@
 // -*- mode: C; indent-tabs-mode: nil; c-basic-offset: 2; tab-width: 2; -*-
 
 #include <assert.h>  // For internal sanity checks
+#include <omnic/allocator.h>
+#include <omnic/typedsort.h>
 #include <omnic/vector.h>
-#include <stdlib.h>  // For malloc, realloc, free
-#include <string.h>  // For memcpy
+#include <stdint.h>  // For uint64_t, SIZE_MAX
+#include <string.h>  // For memcpy, memmove, memset
 
 #define OC_VECTOR_INITIAL_CAPACITY 8
 
@@ -11,52 +13,213 @@
 
 // --- Struct Definition ---
 // This is the actual implementation, hidden from the user.
+//
+// A vector may carry an inline buffer of `inline_capacity` elements placed
+// OC_VECTOR_HEADER_SIZE bytes after the struct, in the same allocation or
+// in caller storage. Elements live there until they outgrow it; they then
+// move to a heap buffer, and back into the inline buffer if the vector is
+// shrunk to fit again.
 struct oc_vector {
-  char* data;           // Use char* for byte-level pointer arithmetic
-  size_t element_size;  // Size of each element in bytes
-  size_t size;          // Number of elements currently in the vector
-  size_t capacity;      // Number of elements the vector can hold
+  char* data;              // Use char* for byte-level pointer arithmetic
+  size_t element_size;     // Size of each element in bytes
+  size_t size;             // Number of elements currently in the vector
+  size_t capacity;         // Number of elements the vector can hold
+  size_t inline_capacity;  // Elements that fit in the inline buffer
+  bool owns_self;          // False if the struct lives in caller storage
+  // Source of the struct's own block and of the heap buffer.
+  const oc_allocator_t* allocator;
 };
 
+_Static_assert(sizeof(struct oc_vector) <= OC_VECTOR_HEADER_SIZE,
+               "OC_VECTOR_HEADER_SIZE must cover struct oc_vector");
+_Static_assert(OC_VECTOR_HEADER_SIZE % _Alignof(max_align_t) == 0,
+               "Inline elements must be suitably aligned");
+
+static inline char* inline_data(oc_vector_t* vec) {
+  return (char*)vec + OC_VECTOR_HEADER_SIZE;
+}
+
+static inline bool is_inline(const oc_vector_t* vec) {
+  return vec->inline_capacity > 0 &&
+         vec->data == (const char*)vec + OC_VECTOR_HEADER_SIZE;
+}
+
+// Size of the block holding the struct and its inline buffer.
+static inline size_t self_bytes(const oc_vector_t* vec) {
+  return OC_VECTOR_HEADER_SIZE + vec->inline_capacity * vec->element_size;
+}
+
+static inline void free_heap_data(oc_vector_t* vec) {
+  if (!is_inline(vec)) {
+    oc_allocator_free(vec->allocator, vec->data,
+                      vec->capacity * vec->element_size);
+  }
+}
+
 /* -------------------------------------------------------------------------- */
 
+// Sets up a vector whose inline buffer follows the struct, empty and with
+// its elements inline.
+static oc_vector_t* init_header(void* memory, size_t element_size,
+                                size_t inline_capacity,
+                                const oc_allocator_t* allocator,
+                                bool owns_self) {
+  oc_vector_t* vec = memory;
+  vec->element_size = element_size;
+  vec->size = 0;
+  vec->inline_capacity = inline_capacity;
+  vec->capacity = inline_capacity;
+  vec->data = inline_capacity > 0 ? inline_data(vec) : NULL;
+  vec->allocator = allocator ? allocator : oc_allocator_default();
+  vec->owns_self = owns_self;
+  return vec;
+}
+
+// Allocates a vector and its inline buffer in one block.
+static oc_vector_t* create_vector(size_t element_size, size_t inline_capacity,
+                                  const oc_allocator_t* allocator) {
+  if (element_size == 0 ||
+      inline_capacity > (SIZE_MAX - OC_VECTOR_HEADER_SIZE) / element_size) {
+    return NULL;
+  }
+
+  void* memory = oc_allocator_alloc(
+      allocator, OC_VECTOR_HEADER_SIZE + inline_capacity * element_size);
+  if (!memory) {
+    return NULL;
+  }
+  return init_header(memory, element_size, inline_capacity, allocator, true);
+}
+
 oc_vector_t* oc_vector_create(size_t element_size) {
-  if (element_size == 0) {
+  return create_vector(element_size, OC_VECTOR_INITIAL_CAPACITY, NULL);
+}
+
+oc_vector_t* oc_vector_create_small(size_t element_size,
+                                    size_t inline_capacity) {
+  return create_vector(element_size, inline_capacity, NULL);
+}
+
+oc_vector_t* oc_vector_create_with_allocator(size_t element_size,
+                                             const oc_allocator_t* allocator) {
+  return create_vector(element_size, OC_VECTOR_INITIAL_CAPACITY, allocator);
+}
+
+oc_vector_t* oc_vector_init_inline(void* storage, size_t storage_size,
+                                   size_t element_size) {
+  if (!storage || element_size == 0 || storage_size < OC_VECTOR_HEADER_SIZE ||
+      (uintptr_t)storage % _Alignof(max_align_t) != 0) {
     return NULL;
   }
+  return init_header(storage, element_size,
+                     (storage_size - OC_VECTOR_HEADER_SIZE) / element_size,
+                     NULL, false);
+}
 
-  oc_vector_t* vec = malloc(sizeof(oc_vector_t));
-  if (!vec) {
+oc_vector_t* oc_vector_create_from_buffer(size_t element_size, void* data,
+                                          size_t size, size_t capacity) {
+  if (element_size == 0 || size > capacity || (!data && capacity > 0)) {
     return NULL;
   }
 
-  vec->element_size = element_size;
-  vec->size = 0;
-  vec->capacity = OC_VECTOR_INITIAL_CAPACITY;
-  vec->data = malloc(vec->capacity * vec->element_size);
-  if (!vec->data) {
-    free(vec);  // Clean up partially allocated struct
+  oc_vector_t* vec = create_vector(element_size, 0, NULL);
+  if (!vec) {
     return NULL;
   }
 
+  vec->data = data;
+  vec->size = size;
+  vec->capacity = capacity;
   return vec;
 }
 
+oc_error_code_t oc_vector_release(oc_vector_t* vec, void** data, size_t* size,
+                                  size_t* capacity) {
+  if (!vec || !data) {
+    return OC_ERROR_INVALID_ARG;
+  }
+
+  char* buffer = vec->data;
+  size_t buffer_capacity = vec->capacity;
+  if (is_inline(vec)) {
+    // The inline buffer goes away with the vector; copy out to the heap.
+    buffer = NULL;
+    buffer_capacity = vec->size;
+    if (vec->size > 0) {
+      buffer = oc_allocator_alloc(vec->allocator,
+                                  vec->size * vec->element_size);
+      if (!buffer) {
+        return OC_ERROR_ALLOC;
+      }
+      memcpy(buffer, vec->data, vec->size * vec->element_size);
+    }
+  }
+
+  *data = buffer;
+  if (size) {
+    *size = vec->size;
+  }
+  if (capacity) {
+    *capacity = buffer_capacity;
+  }
+  if (vec->owns_self) {
+    oc_allocator_free(vec->allocator, vec, self_bytes(vec));
+  }
+  return OC_SUCCESS;
+}
+
 void oc_vector_destroy(oc_vector_t* vec) {
   if (vec) {
-    free(vec->data);
-    free(vec);
+    free_heap_data(vec);
+    if (vec->owns_self) {
+      oc_allocator_free(vec->allocator, vec, self_bytes(vec));
+    }
   }
 }
 
-// Internal helper function to handle resizing
-static oc_error_code_t oc_vector_resize(oc_vector_t* vec, size_t new_capacity) {
-  if (new_capacity <= vec->capacity) {
-    // No need to resize down (for this simple implementation)
+bool oc_vector_is_inline(const oc_vector_t* vec) {
+  return vec && is_inline(vec);
+}
+
+const oc_allocator_t* oc_vector_allocator(const oc_vector_t* vec) {
+  return vec ? vec->allocator : NULL;
+}
+
+// Sets the capacity to exactly `new_capacity` elements, which must not be
+// below the size. A capacity that fits the inline buffer moves the elements
+// there and frees the heap buffer; without an inline buffer, a capacity of
+// 0 frees the heap buffer.
+static oc_error_code_t set_capacity(oc_vector_t* vec, size_t new_capacity) {
+  size_t es = vec->element_size;
+  if (vec->inline_capacity > 0 && new_capacity <= vec->inline_capacity) {
+    if (!is_inline(vec)) {
+      memcpy(inline_data(vec), vec->data, vec->size * es);
+      free_heap_data(vec);
+      vec->data = inline_data(vec);
+    }
+    vec->capacity = vec->inline_capacity;
+    return OC_SUCCESS;
+  }
+  if (new_capacity == 0) {
+    free_heap_data(vec);
+    vec->data = NULL;
+    vec->capacity = 0;
     return OC_SUCCESS;
   }
+  if (new_capacity > SIZE_MAX / es) {
+    return OC_ERROR_ALLOC;
+  }
 
-  char* new_data = realloc(vec->data, new_capacity * vec->element_size);
+  char* new_data;
+  if (is_inline(vec)) {
+    new_data = oc_allocator_alloc(vec->allocator, new_capacity * es);
+    if (new_data) {
+      memcpy(new_data, vec->data, vec->size * es);
+    }
+  } else {
+    new_data = oc_allocator_realloc(vec->allocator, vec->data,
+                                    vec->capacity * es, new_capacity * es);
+  }
   if (!new_data) {
     return OC_ERROR_ALLOC;
   }
@@ -66,6 +229,24 @@ static oc_error_code_t oc_vector_resize(oc_vector_t* vec, size_t new_capacity) {
   return OC_SUCCESS;
 }
 
+// Makes room for `extra` more elements. Growth at least doubles the
+// capacity, so a sequence of appends costs amortized O(1) per element.
+static oc_error_code_t reserve_extra(oc_vector_t* vec, size_t extra) {
+  if (extra > SIZE_MAX - vec->size) {
+    return OC_ERROR_ALLOC;
+  }
+  size_t needed = vec->size + extra;
+  if (needed <= vec->capacity) {
+    return OC_SUCCESS;
+  }
+  size_t new_capacity =
+      vec->capacity == 0 ? OC_VECTOR_INITIAL_CAPACITY : vec->capacity;
+  while (new_capacity < needed) {
+    new_capacity = new_capacity > SIZE_MAX / 2 ? needed : new_capacity << 1;
+  }
+  return set_capacity(vec, new_capacity);
+}
+
 oc_error_code_t oc_vector_push_back(oc_vector_t* vec, const void* element) {
   if (!vec || !element) {
     return OC_ERROR_INVALID_ARG;
@@ -73,9 +254,7 @@ oc_error_code_t oc_vector_push_back(oc_vector_t* vec, const void* element) {
 
   // Resize if necessary
   if (vec->size >= vec->capacity) {
-    size_t new_capacity =
-        vec->capacity == 0 ? OC_VECTOR_INITIAL_CAPACITY : vec->capacity << 1;
-    oc_error_code_t err = oc_vector_resize(vec, new_capacity);
+    oc_error_code_t err = reserve_extra(vec, 1);
     if (err != OC_SUCCESS) {
       return err;
     }
@@ -101,3 +280,293 @@ size_t oc_vector_size(const oc_vector_t* vec) { return vec ? vec->size : 0; }
 size_t oc_vector_capacity(const oc_vector_t* vec) {
   return vec ? vec->capacity : 0;
 }
+
+size_t oc_vector_element_size(const oc_vector_t* vec) {
+  return vec ? vec->element_size : 0;
+}
+
+/* -------------------------------------------------------------------------- */
+
+// --- Bulk Operations ---
+
+void* oc_vector_data(oc_vector_t* vec) { return vec ? vec->data : NULL; }
+
+oc_error_code_t oc_vector_reserve(oc_vector_t* vec, size_t capacity) {
+  if (!vec) {
+    return OC_ERROR_INVALID_ARG;
+  }
+  if (capacity <= vec->capacity) {
+    return OC_SUCCESS;
+  }
+  return set_capacity(vec, capacity);
+}
+
+oc_error_code_t oc_vector_append_n(oc_vector_t* vec, const void* elements,
+                                   size_t count) {
+  if (!vec) {
+    return OC_ERROR_INVALID_ARG;
+  }
+  return oc_vector_insert_range(vec, vec->size, elements, count);
+}
+
+oc_error_code_t oc_vector_insert_range(oc_vector_t* vec, size_t index,
+                                       const void* elements, size_t count) {
+  if (!vec || (!elements && count > 0)) {
+    return OC_ERROR_INVALID_ARG;
+  }
+  if (index > vec->size) {
+    return OC_ERROR_OUT_OF_BOUNDS;
+  }
+  if (count == 0) {
+    return OC_SUCCESS;
+  }
+
+  oc_error_code_t err = reserve_extra(vec, count);
+  if (err != OC_SUCCESS) {
+    return err;
+  }
+
+  size_t es = vec->element_size;
+  char* at = vec->data + index * es;
+  if (index < vec->size) {
+    memmove(at + count * es, at, (vec->size - index) * es);
+  }
+  memcpy(at, elements, count * es);
+  vec->size += count;
+  return OC_SUCCESS;
+}
+
+oc_error_code_t oc_vector_erase_range(oc_vector_t* vec, size_t index,
+                                      size_t count) {
+  if (!vec) {
+    return OC_ERROR_INVALID_ARG;
+  }
+  if (index > vec->size || count > vec->size - index) {
+    return OC_ERROR_OUT_OF_BOUNDS;
+  }
+
+  size_t es = vec->element_size;
+  size_t tail = vec->size - index - count;
+  if (count > 0 && tail > 0) {
+    memmove(vec->data + index * es, vec->data + (index + count) * es,
+            tail * es);
+  }
+  vec->size -= count;
+  return OC_SUCCESS;
+}
+
+oc_error_code_t oc_vector_resize(oc_vector_t* vec, size_t new_size,
+                                 const void* fill) {
+  if (!vec) {
+    return OC_ERROR_INVALID_ARG;
+  }
+  if (new_size > vec->size) {
+    oc_error_code_t err = reserve_extra(vec, new_size - vec->size);
+    if (err != OC_SUCCESS) {
+      return err;
+    }
+
+    size_t es = vec->element_size;
+    char* dest = vec->data + vec->size * es;
+    size_t added = new_size - vec->size;
+    if (!fill) {
+      memset(dest, 0, added * es);
+    } else if (added > 0) {
+      // Copy one element, then double the filled block each pass.
+      memcpy(dest, fill, es);
+      for (size_t done = 1; done < added;) {
+        size_t n = done < added - done ? done : added - done;
+        memcpy(dest + done * es, dest, n * es);
+        done += n;
+      }
+    }
+  }
+  vec->size = new_size;
+  return OC_SUCCESS;
+}
+
+oc_error_code_t oc_vector_shrink_to_fit(oc_vector_t* vec) {
+  if (!vec) {
+    return OC_ERROR_INVALID_ARG;
+  }
+  if (vec->size == vec->capacity) {
+    return OC_SUCCESS;
+  }
+  return set_capacity(vec, vec->size);
+}
+
+/* -------------------------------------------------------------------------- */
+
+// --- Sorting ---
+// Introsort over the vector's own storage, the byte-level counterpart of
+// name_sort() in typedsort.h: median-of-3 (ninther for large ranges) Hoare
+// partitioning, insertion sort for small ranges and heap sort once the
+// recursion gets too deep. Partitioning and heap sort exchange elements in
+// place, 8 bytes at a time. Insertion sort finds each element's place
+// first, then saves the element, shifts the run in between with one
+// memmove and stores it: that needs one element-sized temporary, which
+// lives on the stack up to OC_VECTOR_SORT_STACK_TMP bytes.
+
+// Largest element whose insertion-sort temporary is kept on the stack.
+#define OC_VECTOR_SORT_STACK_TMP 256
+
+typedef int (*oc_vector_cmp_t)(const void*, const void*);
+
+static inline void swap_elements(char* a, char* b, size_t size) {
+  uint64_t t;
+  if (size == sizeof(uint32_t)) {  // int and float elements
+    uint32_t u;
+    memcpy(&u, a, sizeof(u));
+    memcpy(a, b, sizeof(u));
+    memcpy(b, &u, sizeof(u));
+    return;
+  }
+  for (; size >= sizeof(t); size -= sizeof(t)) {
+    memcpy(&t, a, sizeof(t));
+    memcpy(a, b, sizeof(t));
+    memcpy(b, &t, sizeof(t));
+    a += sizeof(t);
+    b += sizeof(t);
+  }
+  for (; size > 0; --size) {
+    char c = *a;
+    *a++ = *b;
+    *b++ = c;
+  }
+}
+
+// `tmp` holds one element, or is NULL to rotate by swaps instead.
+static void insertion_sort_bytes(char* d, size_t n, size_t size,
+                                 oc_vector_cmp_t cmp, char* tmp) {
+  for (size_t i = 1; i < n; ++i) {
+    char* cur = d + i * size;
+    char* p = cur;
+    while (p > d && cmp(cur, p - size) < 0)
+      p -= size;
+    if (p == cur)
+      continue;
+    if (tmp) {
+      memcpy(tmp, cur, size);
+      memmove(p + size, p, (size_t)(cur - p));
+      memcpy(p, tmp, size);
+    } else {
+      for (char* q = cur; q > p; q -= size)
+        swap_elements(q, q - size, size);
+    }
+  }
+}
+
+// Sifts element s down within the max-heap d[0, n).
+static void heap_adjust_bytes(char* d, size_t s, size_t n, size_t size,
+                              oc_vector_cmp_t cmp) {
+  for (size_t j = 2 * s + 1; j < n; j = 2 * j + 1) {
+    if (j + 1 < n && cmp(d + j * size, d + (j + 1) * size) < 0)
+      ++j;
+    if (cmp(d + s * size, d + j * size) >= 0)
+      break;
+    swap_elements(d + s * size, d + j * size, size);
+    s = j;
+  }
+}
+
+static void heap_sort_bytes(char* d, size_t n, size_t size,
+                            oc_vector_cmp_t cmp) {
+  if (n < 2)
+    return;
+  for (size_t i = n / 2; i-- > 0;)
+    heap_adjust_bytes(d, i, n, size, cmp);
+  for (size_t i = n - 1; i > 0; --i) {
+    swap_elements(d, d + i * size, size);
+    heap_adjust_bytes(d, 0, i, size, cmp);
+  }
+}
+
+static size_t median3_bytes(const char* d, size_t x, size_t y, size_t z,
+                            size_t size, oc_vector_cmp_t cmp) {
+  const char *a = d + x * size, *b = d + y * size, *c = d + z * size;
+  if (cmp(a, b) < 0) {
+    if (cmp(b, c) < 0)
+      return y;
+    return cmp(a, c) < 0 ? z : x;
+  }
+  if (cmp(a, c) < 0)
+    return x;
+  return cmp(b, c) < 0 ? z : y;
+}
+
+// Partitions d[0, n) around a pivot moved to d[0]; returns its final index.
+static size_t partition_bytes(char* d, size_t n, size_t size,
+                              oc_vector_cmp_t cmp) {
+  size_t mid = n / 2, last = n - 1, m;
+  if (n >= OC_TYPEDSORT_NINTHER_THRESHOLD) {
+    size_t s = n / 8;
+    m = median3_bytes(
+        d, median3_bytes(d, 0, s, 2 * s, size, cmp),
+        median3_bytes(d, mid - s, mid, mid + s, size, cmp),
+        median3_bytes(d, last - 2 * s, last - s, last, size, cmp), size, cmp);
+  } else {
+    m = median3_bytes(d, 0, mid, last, size, cmp);
+  }
+  swap_elements(d, d + m * size, size);
+
+  size_t i = 0, j = n;
+  for (;;) {
+    while (cmp(d + ++i * size, d) < 0) {
+      if (i == last)
+        break;
+    }
+    while (cmp(d, d + --j * size) < 0) {
+    }
+    if (i >= j)
+      break;
+    swap_elements(d + i * size, d + j * size, size);
+  }
+  swap_elements(d, d + j * size, size);
+  return j;
+}
+
+static void intro_loop_bytes(char* d, size_t n, size_t size,
+                             oc_vector_cmp_t cmp, char* tmp, unsigned depth) {
+  while (n > OC_TYPEDSORT_INSERTION_CUTOFF) {
+    if (depth == 0) {
+      heap_sort_bytes(d, n, size, cmp);
+      return;
+    }
+    --depth;
+    size_t p = partition_bytes(d, n, size, cmp);
+    // Recurse into the smaller side, loop on the larger one.
+    if (p < n - p - 1) {
+      intro_loop_bytes(d, p, size, cmp, tmp, depth);
+      d += (p + 1) * size;
+      n -= p + 1;
+    } else {
+      intro_loop_bytes(d + (p + 1) * size, n - p - 1, size, cmp, tmp, depth);
+      n = p;
+    }
+  }
+  insertion_sort_bytes(d, n, size, cmp, tmp);
+}
+
+oc_error_code_t oc_vector_sort(oc_vector_t* vec,
+                               int (*cmp)(const void*, const void*)) {
+  if (!vec || !cmp) {
+    return OC_ERROR_INVALID_ARG;
+  }
+  if (vec->size < 2) {
+    return OC_SUCCESS;
+  }
+
+  // Larger elements borrow a temporary from the allocator; without one the
+  // insertion sort falls back to swaps, so sorting never fails.
+  char stack_tmp[OC_VECTOR_SORT_STACK_TMP];
+  char* tmp = stack_tmp;
+  if (vec->element_size > sizeof(stack_tmp)) {
+    tmp = oc_allocator_alloc(vec->allocator, vec->element_size);
+  }
+  intro_loop_bytes(vec->data, vec->size, vec->element_size, cmp, tmp,
+                   _oc_typedsort_depth_limit(vec->size));
+  if (tmp != stack_tmp) {
+    oc_allocator_free(vec->allocator, tmp, vec->element_size);
+  }
+  return OC_SUCCESS;
+}